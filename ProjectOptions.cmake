@@ -86,6 +86,7 @@ macro(vkl_setup_options)
   endif()
 
   option(vkl_BUILD_FUZZ_TESTS "Enable fuzz testing executable" ${DEFAULT_FUZZER})
+  option(vkl_BUILD_BENCHMARKS "Enable benchmark executables" OFF)
 
 endmacro()
 
@@ -0,0 +1,172 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// GPU frustum culling of N randomly placed objects with GpuCuller, checked against the same tests run on the CPU.
+// Runs headless, so it also serves as the lavapipe check in CI (VKL_DEVICE=llvmpipe): it exits with a failure when the
+// compacted draw list differs from the CPU reference by more than the rounding of objects touching a plane. Times are
+// submit to fence, so they include the submission cost.
+// NOLINTBEGIN(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers, *-uppercase-literal-suffix)
+#include <vkl/GpuCuller.hpp>
+#include <vkl/timer/Timer.hpp>
+
+namespace {
+    constexpr std::size_t warmupRuns = 2;
+    constexpr std::size_t measuredRuns = 8;
+    constexpr float sceneExtent = 200.0f;
+
+    lve::MeshData cube() {
+        lve::MeshData mesh;
+        for(int corner = 0; corner < 8; corner++) {
+            const glm::vec3 position{corner & 1 ? 0.5f : -0.5f, corner & 2 ? 0.5f : -0.5f, corner & 4 ? 0.5f : -0.5f};
+            mesh.vertices.emplace_back(lve::Model::Vertex{.position = position, .color = position + 0.5f});
+        }
+        mesh.indices = {0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6, 0, 1, 4, 1, 5, 4, 2, 6, 3, 3, 6, 7, 0, 4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5};
+        return mesh;
+    }
+
+    glm::mat4 randomTransform(std::mt19937 &random) {
+        std::uniform_real_distribution<float> position{-sceneExtent, sceneExtent};
+        std::uniform_real_distribution<float> unit{-1.0f, 1.0f};
+        std::uniform_real_distribution<float> scale{0.5f, 3.0f};
+        const glm::vec3 axis{unit(random), unit(random), unit(random) + 2.0f};
+        return glm::translate(glm::mat4{1.0f}, glm::vec3{position(random), position(random), position(random)}) *
+               glm::rotate(glm::mat4{1.0f}, unit(random) * glm::pi<float>(), glm::normalize(axis)) *
+               glm::scale(glm::mat4{1.0f}, glm::vec3{scale(random), scale(random), scale(random)});
+    }
+
+    struct WorldBounds {
+        glm::vec3 sphereCenter;
+        float sphereRadius;
+        glm::vec3 boxCenter;
+        glm::vec3 boxExtent;
+    };
+
+    WorldBounds worldBounds(const lve::GpuScene &scene, uint32_t object) {
+        const glm::mat4 &transform = scene.objectData()[object].transform;
+        const lve::Model::Bounds &bounds = scene.mesh(scene.objectData()[object].meshId).bounds;
+        const float scale = std::max({glm::length(glm::vec3{transform[0]}), glm::length(glm::vec3{transform[1]}),
+                                      glm::length(glm::vec3{transform[2]})});
+        const glm::mat3 absolute{glm::abs(glm::vec3{transform[0]}), glm::abs(glm::vec3{transform[1]}), glm::abs(glm::vec3{transform[2]})};
+        return WorldBounds{.sphereCenter = glm::vec3{transform * glm::vec4{bounds.center, 1.0f}},
+                           .sphereRadius = bounds.radius * scale,
+                           .boxCenter = glm::vec3{transform * glm::vec4{0.5f * (bounds.min + bounds.max), 1.0f}},
+                           .boxExtent = absolute * (0.5f * (bounds.max - bounds.min))};
+    }
+
+    // mirrors main() of cull.comp
+    std::vector<uint32_t> cullOnCpu(const lve::GpuScene &scene, const lve::Frustum &frustum) {
+        std::vector<uint32_t> visible;
+        for(uint32_t object = 0; object < scene.objectCount(); object++) {
+            const WorldBounds world = worldBounds(scene, object);
+            if(frustum.intersectsSphere(world.sphereCenter, world.sphereRadius) &&
+               frustum.intersectsBox(world.boxCenter, world.boxExtent)) {
+                visible.emplace_back(object);
+            }
+        }
+        return visible;
+    }
+
+    // the GPU may contract or round the plane tests differently, an object touching a plane can go either way
+    bool onBoundary(const lve::GpuScene &scene, const lve::Frustum &frustum, uint32_t object) {
+        const WorldBounds world = worldBounds(scene, object);
+        return std::ranges::any_of(frustum.planes, [&](const glm::vec4 &plane) {
+            const glm::vec3 normal{plane};
+            const float epsilon = 1e-3f * std::max(1.0f, std::abs(plane.w));
+            return std::abs(glm::dot(normal, world.sphereCenter) + plane.w + world.sphereRadius) <= epsilon ||
+                   std::abs(glm::dot(normal, world.boxCenter) + plane.w + glm::dot(glm::abs(normal), world.boxExtent)) <= epsilon;
+        });
+    }
+
+    std::vector<VkDrawIndexedIndirectCommand> readCommands(lve::Device &device, const lve::GpuScene &scene, uint32_t count) {
+        const VkDeviceSize size = VkDeviceSize{sizeof(VkDrawIndexedIndirectCommand)} * std::max(count, 1U);
+        VkBuffer readback{};
+        lve::Allocation readbackAllocation{};
+        device.createBuffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, readback, readbackAllocation);
+
+        VkCommandBuffer commandBuffer = device.beginSingleTimeCommands();
+        const VkBufferCopy copy{.srcOffset = 0, .dstOffset = 0, .size = size};
+        vkCmdCopyBuffer(commandBuffer, scene.drawCommandBuffer(), readback, 1, &copy);
+        const VkMemoryBarrier barrier{.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                                      .pNext = nullptr,
+                                      .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                                      .dstAccessMask = VK_ACCESS_HOST_READ_BIT};
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0,
+                             nullptr);
+        device.endSingleTimeCommands(commandBuffer);
+
+        std::vector<VkDrawIndexedIndirectCommand> commands(count);
+        std::memcpy(commands.data(), readbackAllocation.mapped, commands.size() * sizeof(VkDrawIndexedIndirectCommand));
+        device.destroyBuffer(readback, readbackAllocation);
+        return commands;
+    }
+
+    bool runCase(lve::Device &device, std::size_t objectCount) {
+        std::mt19937 random{42};
+        lve::GpuScene scene{device};
+        const uint32_t meshId = scene.addMesh(cube());
+        for(std::size_t object = 0; object < objectCount; object++) { scene.addObject(randomTransform(random), meshId); }
+        scene.build();
+        lve::GpuCuller culler{device, scene, 1};
+
+        const glm::mat4 view = glm::lookAt(glm::vec3{0.0f}, glm::vec3{0.0f, 0.0f, -1.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+        const glm::mat4 projection = glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, sceneExtent * 0.75f);
+        const lve::Frustum frustum = lve::Frustum::fromViewProjection(projection * view);
+
+        long double gpuNs = 0;
+        for(std::size_t run = 0; run < warmupRuns + measuredRuns; run++) {
+            const vnd::Timer timer{"gpu cull"};
+            VkCommandBuffer commandBuffer = device.beginSingleTimeCommands();
+            culler.record(commandBuffer, 0, frustum);
+            device.endSingleTimeCommands(commandBuffer);
+            if(run >= warmupRuns) { gpuNs += timer.make_time(); }
+        }
+        gpuNs /= C_LD(measuredRuns);
+
+        const vnd::Timer cpuTimer{"cpu cull"};
+        const std::vector<uint32_t> expected = cullOnCpu(scene, frustum);
+        const long double cpuNs = cpuTimer.make_time();
+
+        const auto stats = culler.stats(0).value_or(lve::GpuCuller::Stats{});
+        const std::vector<VkDrawIndexedIndirectCommand> commands = readCommands(device, scene, stats.visible);
+        std::vector<uint32_t> visible;
+        visible.reserve(commands.size());
+        bool valid = stats.visible + stats.culled == objectCount;
+        for(const VkDrawIndexedIndirectCommand &command : commands) {
+            const lve::GpuScene::MeshRange &range = scene.mesh(meshId);
+            valid = valid && command.instanceCount == 1 && command.indexCount == range.indexCount &&
+                    command.firstIndex == range.firstIndex && command.vertexOffset == range.vertexOffset;
+            visible.emplace_back(command.firstInstance);
+        }
+        std::ranges::sort(visible);
+        std::vector<uint32_t> differing;
+        std::ranges::set_symmetric_difference(visible, expected, std::back_inserter(differing));
+        const auto mismatches = std::ranges::count_if(
+            differing, [&](uint32_t object) { return object >= scene.objectCount() || !onBoundary(scene, frustum, object); });
+        valid = valid && mismatches == 0;
+
+        LINFO("{:>8} objects | {:>7} visible | gpu {:>12} | cpu reference {:>12} | {}", objectCount, stats.visible,
+              vnd::Timer::make_time_str(gpuNs), vnd::Timer::make_time_str(cpuNs), valid ? "matches" : "MISMATCH");
+        if(!valid) {
+            LERROR("GPU culling kept {} objects, the CPU reference {}, {} culled differently", visible.size(), expected.size(), mismatches);
+        }
+        return valid;
+    }
+}  // namespace
+
+int main() {
+    INIT_LOG()
+    try {
+        lve::Device device{};
+        bool valid = true;
+        for(const std::size_t objectCount : {std::size_t{1}, std::size_t{1'000}, std::size_t{100'000}, std::size_t{1'000'000}}) {
+            valid = runCase(device, objectCount) && valid;
+        }
+        return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+    } catch(const std::exception &e) {
+        LERROR("Unhandled exception in cull_benchmark: {}", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+// NOLINTEND(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers, *-uppercase-literal-suffix)
@@ -0,0 +1,79 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// OBJ load throughput on a generated ~50 MB grid mesh, per worker thread count, then cold versus warm MeshCache loads.
+// NOLINTBEGIN(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers)
+#include <vkl/MeshCache.hpp>
+#include <vkl/ObjLoader.hpp>
+#include <vkl/timer/Timer.hpp>
+
+namespace {
+    constexpr std::size_t targetBytes = std::size_t{50} << 20;
+
+    /// Writes square grids of quads with positions, uvs and normals until the file reaches targetBytes.
+    fs::path writeGrid(const fs::path &path) {
+        constexpr int side = 256;
+        std::string text;
+        text.reserve(targetBytes + (std::size_t{1} << 20));
+        int base = 0;
+        for(int grid = 0; text.size() < targetBytes; grid++) {
+            for(int y = 0; y <= side; y++) {
+                for(int x = 0; x <= side; x++) {
+                    text += FORMAT("v {:.6f} {:.6f} {:.6f}\nvt {:.6f} {:.6f}\nvn 0 0 1\n", C_LD(x) / side, C_LD(y) / side, C_LD(grid),
+                                   C_LD(x) / side, C_LD(y) / side);
+                }
+            }
+            for(int y = 0; y < side; y++) {
+                for(int x = 0; x < side; x++) {
+                    const int a = base + y * (side + 1) + x + 1;
+                    const int b = a + 1;
+                    const int c = a + side + 2;
+                    const int d = a + side + 1;
+                    text += FORMAT("f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2} {3}/{3}/{3}\n", a, b, c, d);
+                }
+            }
+            base += (side + 1) * (side + 1);
+        }
+
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};  // NOLINT(*-signed-bitwise)
+        file.write(text.data(), C_LL(text.size()));
+        if(!file) [[unlikely]] { throw std::runtime_error(FORMAT("failed to write {}", path.string())); }
+        return path;
+    }
+}  // namespace
+
+int main() {
+    INIT_LOG()
+    try {
+        const fs::path path = writeGrid(fs::temp_directory_path() / "vkl_obj_benchmark.obj");
+        const auto fileSize = fs::file_size(path);
+        for(const uint32_t threadCount : {1U, 2U, 4U, 8U, 16U}) {
+            lve::ThreadPool pool{threadCount};
+            const vnd::Timer timer{"obj"};
+            const lve::MeshData mesh = lve::ObjLoader::load(path, pool);
+            const long double elapsedNs = timer.make_time();
+            LINFO("{:>2} threads | {:.1f} MB in {} | {:>8.1f} MB/s | {} vertices, {} indices", threadCount, C_LD(fileSize) / 1e6L,
+                  vnd::Timer::make_time_str(elapsedNs), C_LD(fileSize) / 1e6L / (elapsedNs * 1e-9L), mesh.vertices.size(),
+                  mesh.indices.size());
+        }
+
+        lve::Device device{};
+        lve::ThreadPool pool{};
+        const lve::MeshCache cache{fs::temp_directory_path() / "vkl_obj_benchmark_cache"};
+        fs::remove(cache.cachePathOf(path));
+        for(const std::string_view pass : {"cold", "warm"}) {
+            const vnd::Timer timer{"mesh cache"};
+            const auto model = cache.loadObj(device, path, pool);
+            LINFO("MeshCache {} load: {} for {} vertices, {} indices", pass, vnd::Timer::make_time_str(timer.make_time()),
+                  model->vertexCount(), model->indexCount());
+        }
+        fs::remove_all(cache.directory());
+        fs::remove(path);
+    } catch(const std::exception &e) {
+        LERROR("Unhandled exception in obj_benchmark: {}", e.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+// NOLINTEND(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers)
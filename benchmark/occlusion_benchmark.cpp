@@ -0,0 +1,358 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// A synthetic city seen from street level, where the nearest blocks hide most of the others, drawn headless three ways:
+// every object, frustum culling with GpuCuller, and two-phase occlusion culling with OcclusionCuller and DepthPyramid.
+// Reports draws, triangles submitted and GPU time (timestamp queries, submit to fence when the queue has none) of the
+// steady state: the camera does not move, so after the warm-up frames the early phase draws all the visible buildings.
+// NOLINTBEGIN(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers, *-uppercase-literal-suffix)
+#include <vkl/GpuCuller.hpp>
+#include <vkl/OcclusionCuller.hpp>
+#include <vkl/Pipeline.hpp>
+#include <vkl/Window.hpp>
+#include <vkl/timer/Timer.hpp>
+
+namespace {
+    constexpr std::size_t warmupFrames = 4;
+    constexpr std::size_t measuredFrames = 16;
+    constexpr VkExtent2D extent{1920, 1080};
+    constexpr VkFormat colorFormat = VK_FORMAT_B8G8R8A8_UNORM;
+    constexpr VkFormat depthFormat = VK_FORMAT_D32_SFLOAT;
+    constexpr uint32_t citySide = 64;          // blocks per side
+    constexpr float blockSize = 12.0f;         // a building and its street
+    constexpr uint32_t faceSubdivisions = 16;  // quads per building face edge
+
+    enum class Mode : uint8_t { All, Frustum, Occlusion };
+
+    std::string_view toString(Mode mode) {
+        switch(mode) {
+        case Mode::All:
+            return "all";
+        case Mode::Frustum:
+            return "frustum";
+        case Mode::Occlusion:
+            return "occlusion";
+        }
+        return "?";
+    }
+
+    // unit box standing on y = 0, every face split in faceSubdivisions^2 quads so buildings cost real triangles
+    lve::MeshData building() {
+        lve::MeshData mesh;
+        constexpr auto steps = C_F(faceSubdivisions);
+        for(int axis = 0; axis < 3; axis++) {
+            for(const float side : {-0.5f, 0.5f}) {
+                const auto first = C_UI32T(mesh.vertices.size());
+                for(uint32_t row = 0; row <= faceSubdivisions; row++) {
+                    for(uint32_t column = 0; column <= faceSubdivisions; column++) {
+                        glm::vec3 position{};
+                        position[axis] = side;
+                        position[(axis + 1) % 3] = C_F(column) / steps - 0.5f;
+                        position[(axis + 2) % 3] = C_F(row) / steps - 0.5f;
+                        position.y += 0.5f;
+                        mesh.vertices.emplace_back(lve::Model::Vertex{.position = position, .color = glm::vec3{0.3f + 0.2f * C_F(axis)}});
+                    }
+                }
+                for(uint32_t row = 0; row < faceSubdivisions; row++) {
+                    for(uint32_t column = 0; column < faceSubdivisions; column++) {
+                        const uint32_t corner = first + row * (faceSubdivisions + 1) + column;
+                        const uint32_t above = corner + faceSubdivisions + 1;
+                        mesh.indices.insert(mesh.indices.end(), {corner, corner + 1, above, above, corner + 1, above + 1});
+                    }
+                }
+            }
+        }
+        return mesh;
+    }
+
+    void buildCity(lve::GpuScene &scene) {
+        std::mt19937 random{7};
+        std::uniform_real_distribution<float> height{4.0f, 40.0f};
+        std::uniform_real_distribution<float> footprint{0.6f * blockSize, 0.8f * blockSize};
+        const uint32_t meshId = scene.addMesh(building());
+        const float origin = -0.5f * blockSize * C_F(citySide);
+        for(uint32_t row = 0; row < citySide; row++) {
+            for(uint32_t column = 0; column < citySide; column++) {
+                const glm::vec3 position{origin + (C_F(column) + 0.5f) * blockSize, 0.0f, origin + (C_F(row) + 0.5f) * blockSize};
+                scene.addObject(glm::translate(glm::mat4{1.0f}, position) *
+                                    glm::scale(glm::mat4{1.0f}, glm::vec3{footprint(random), height(random), footprint(random)}),
+                                meshId);
+            }
+        }
+        scene.build();
+    }
+
+    // standing in the middle of a street, looking along it
+    glm::mat4 streetCamera() {
+        const float street = 0.5f * blockSize * C_F(citySide % 2);  // x of the street closest to the city center
+        const glm::mat4 view =
+            glm::lookAt(glm::vec3{street, 1.7f, 0.0f}, glm::vec3{street + 0.2f, 1.7f, 1.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+        glm::mat4 projection = glm::perspectiveRH_ZO(glm::radians(70.0f), C_F(extent.width) / C_F(extent.height), 0.1f, 1000.0f);
+        projection[1][1] *= -1.0f;  // Vulkan clip space has y pointing down
+        return projection * view;
+    }
+
+    struct Target {
+        explicit Target(lve::Device &device) : lveDevice{device} {
+            createImage(colorFormat, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_IMAGE_ASPECT_COLOR_BIT, color, colorAllocation, colorView);
+            createImage(depthFormat, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_IMAGE_ASPECT_DEPTH_BIT,
+                        depth, depthAllocation, depthView);
+        }
+        ~Target() {
+            vkDestroyImageView(lveDevice.device(), depthView, nullptr);
+            lveDevice.destroyImage(depth, depthAllocation);
+            vkDestroyImageView(lveDevice.device(), colorView, nullptr);
+            lveDevice.destroyImage(color, colorAllocation);
+        }
+        Target(const Target &) = delete;
+        Target &operator=(const Target &) = delete;
+
+        void createImage(VkFormat format, VkImageUsageFlags usage, VkImageAspectFlags aspect, VkImage &image, lve::Allocation &allocation,
+                         VkImageView &view) {
+            VkImageCreateInfo imageInfo{};
+            imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageInfo.imageType = VK_IMAGE_TYPE_2D;
+            imageInfo.extent = {extent.width, extent.height, 1};
+            imageInfo.mipLevels = 1;
+            imageInfo.arrayLayers = 1;
+            imageInfo.format = format;
+            imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+            imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            imageInfo.usage = usage;
+            imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+            imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            lveDevice.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, image, allocation);
+
+            VkImageViewCreateInfo viewInfo{};
+            viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewInfo.image = image;
+            viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.format = format;
+            viewInfo.subresourceRange = {aspect, 0, 1, 0, 1};
+            VK_CHECK(vkCreateImageView(lveDevice.device(), &viewInfo, nullptr, &view), "failed to create benchmark target view!");
+        }
+
+        void begin(VkCommandBuffer commandBuffer, bool resume) const {
+            std::array<VkImageMemoryBarrier, 2> barriers{};
+            for(VkImageMemoryBarrier &barrier : barriers) {
+                barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            }
+            barriers[0].srcAccessMask = resume ? VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT : 0;
+            barriers[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            barriers[0].oldLayout = resume ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
+            barriers[0].newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            barriers[0].image = color;
+            barriers[0].subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+            barriers[1].srcAccessMask = 0;
+            barriers[1].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            barriers[1].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barriers[1].newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            barriers[1].image = depth;
+            barriers[1].subresourceRange = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1};
+            // DepthPyramid::build hands the depth image back itself
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                                 VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT, 0, 0, nullptr,
+                                 0, nullptr, resume ? 1 : 2, barriers.data());
+
+            VkRenderingAttachmentInfo colorAttachment{};
+            colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+            colorAttachment.imageView = colorView;
+            colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            colorAttachment.loadOp = resume ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_CLEAR;
+            colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+            colorAttachment.clearValue.color = VkClearColorValue{.float32{0.1f, 0.1f, 0.1f, 1.0f}};
+            VkRenderingAttachmentInfo depthAttachment{};
+            depthAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+            depthAttachment.imageView = depthView;
+            depthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            depthAttachment.loadOp = resume ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_CLEAR;
+            depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+            depthAttachment.clearValue.depthStencil = {.depth = 1.0f, .stencil = 0};
+
+            VkRenderingInfo renderingInfo{};
+            renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+            renderingInfo.renderArea = {.offset = {0, 0}, .extent = extent};
+            renderingInfo.layerCount = 1;
+            renderingInfo.colorAttachmentCount = 1;
+            renderingInfo.pColorAttachments = &colorAttachment;
+            renderingInfo.pDepthAttachment = &depthAttachment;
+            vkCmdBeginRendering(commandBuffer, &renderingInfo);
+        }
+
+        lve::Device &lveDevice;
+        VkImage color{};
+        lve::Allocation colorAllocation{};
+        VkImageView colorView{};
+        VkImage depth{};
+        lve::Allocation depthAllocation{};
+        VkImageView depthView{};
+    };
+
+    struct Result {
+        uint64_t draws = 0;
+        uint64_t triangles = 0;
+        long double gpuNs = 0;
+    };
+
+    class Renderer {
+    public:
+        explicit Renderer(lve::Device &device) : lveDevice{device}, target{device} {
+            buildCity(layoutScene);
+            VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+            pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+            const VkDescriptorSetLayout setLayout = layoutScene.descriptorSetLayout();
+            pipelineLayoutInfo.setLayoutCount = 1;
+            pipelineLayoutInfo.pSetLayouts = &setLayout;
+            pipelineLayoutInfo.pushConstantRangeCount = 1;
+            pipelineLayoutInfo.pPushConstantRanges = &lve::GpuScene::CAMERA_PUSH_CONSTANTS;
+            VK_CHECK(vkCreatePipelineLayout(lveDevice.device(), &pipelineLayoutInfo, nullptr, &pipelineLayout),
+                     "failed to create benchmark pipeline layout!");
+
+            lve::PipelineConfigInfo pipelineConfig{};
+            lve::Pipeline::defaultPipelineConfigInfo(pipelineConfig);
+            pipelineConfig.colorFormat = colorFormat;
+            pipelineConfig.depthFormat = depthFormat;
+            pipelineConfig.pipelineLayout = pipelineLayout;
+            pipeline = MAKE_UNIQUE(lve::Pipeline, lveDevice,
+                                   lve::Window::calculateRelativePathToSrcShaders(curentP, "scene_shader.vert.opt.rmp.spv").string(),
+                                   lve::Window::calculateRelativePathToSrcShaders(curentP, "simple_shader.frag.opt.rmp.spv").string(),
+                                   pipelineConfig);
+
+            timestamps = lveDevice.properties.limits.timestampComputeAndGraphics == VK_TRUE;
+            if(timestamps) {
+                VkQueryPoolCreateInfo queryInfo{};
+                queryInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+                queryInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+                queryInfo.queryCount = 2;
+                VK_CHECK(vkCreateQueryPool(lveDevice.device(), &queryInfo, nullptr, &queryPool), "failed to create timestamp query pool!");
+            } else {
+                LWARN("The queue has no timestamps, reporting submit to fence times");
+            }
+        }
+
+        ~Renderer() {
+            vkDestroyQueryPool(lveDevice.device(), queryPool, nullptr);
+            pipeline.reset();
+            vkDestroyPipelineLayout(lveDevice.device(), pipelineLayout, nullptr);
+        }
+
+        Renderer(const Renderer &) = delete;
+        Renderer &operator=(const Renderer &) = delete;
+
+        Result run(Mode mode) {
+            // every mode gets its own scene, the cullers rewrite the indirect buffers of theirs
+            lve::GpuScene scene{lveDevice};
+            buildCity(scene);
+            std::unique_ptr<lve::GpuCuller> frustumCuller;
+            std::unique_ptr<lve::DepthPyramid> pyramid;
+            std::unique_ptr<lve::OcclusionCuller> occlusionCuller;
+            if(mode == Mode::Frustum) { frustumCuller = MAKE_UNIQUE(lve::GpuCuller, lveDevice, scene, 1); }
+            if(mode == Mode::Occlusion) {
+                pyramid = MAKE_UNIQUE(lve::DepthPyramid, lveDevice, extent, target.depthView);
+                occlusionCuller = MAKE_UNIQUE(lve::OcclusionCuller, lveDevice, scene, *pyramid, 1);
+            }
+
+            const glm::mat4 viewProjection = streetCamera();
+            Result result;
+            for(std::size_t frame = 0; frame < warmupFrames + measuredFrames; frame++) {
+                const vnd::Timer timer{"frame"};
+                VkCommandBuffer commandBuffer = lveDevice.beginSingleTimeCommands();
+                if(timestamps) {
+                    vkCmdResetQueryPool(commandBuffer, queryPool, 0, 2);
+                    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, 0);
+                }
+                if(frustumCuller) { frustumCuller->record(commandBuffer, 0, lve::Frustum::fromViewProjection(viewProjection)); }
+                if(occlusionCuller) { occlusionCuller->recordEarly(commandBuffer, 0, viewProjection); }
+                target.begin(commandBuffer, false);
+                draw(commandBuffer, scene, viewProjection);
+                vkCmdEndRendering(commandBuffer);
+                if(occlusionCuller) {
+                    pyramid->build(commandBuffer, target.depth, depthFormat);
+                    occlusionCuller->recordLate(commandBuffer, 0, viewProjection);
+                    target.begin(commandBuffer, true);
+                    draw(commandBuffer, scene, viewProjection);
+                    vkCmdEndRendering(commandBuffer);
+                }
+                if(timestamps) { vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, 1); }
+                lveDevice.endSingleTimeCommands(commandBuffer);
+                const long double wallNs = timer.make_time();
+                if(frame < warmupFrames) { continue; }
+
+                if(timestamps) {
+                    std::array<uint64_t, 2> ticks{};
+                    VK_CHECK(vkGetQueryPoolResults(lveDevice.device(), queryPool, 0, 2, sizeof(ticks), ticks.data(), sizeof(uint64_t),
+                                                   VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT),
+                             "failed to read the timestamps!");
+                    result.gpuNs += C_LD(ticks[1] - ticks[0]) * lveDevice.properties.limits.timestampPeriod;
+                } else {
+                    result.gpuNs += wallNs;
+                }
+            }
+            result.gpuNs /= C_LD(measuredFrames);
+
+            const uint64_t meshTriangles = scene.mesh(0).indexCount / 3;
+            if(frustumCuller) {
+                const auto stats = frustumCuller->stats(0).value_or(lve::GpuCuller::Stats{});
+                result.draws = stats.visible;
+                result.triangles = uint64_t{stats.visible} * meshTriangles;
+            } else if(occlusionCuller) {
+                const auto stats = occlusionCuller->stats(0).value_or(lve::OcclusionCuller::Stats{});
+                result.draws = uint64_t{stats.earlyDraws} + stats.lateDraws;
+                result.triangles = stats.triangles;
+            } else {
+                result.draws = scene.objectCount();
+                result.triangles = uint64_t{scene.objectCount()} * meshTriangles;
+            }
+            return result;
+        }
+
+    private:
+        void draw(VkCommandBuffer commandBuffer, const lve::GpuScene &scene, const glm::mat4 &viewProjection) {
+            const VkViewport viewport{
+                .x = 0.0f, .y = 0.0f, .width = C_F(extent.width), .height = C_F(extent.height), .minDepth = 0.0f, .maxDepth = 1.0f};
+            const VkRect2D scissor{.offset = {0, 0}, .extent = extent};
+            vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+            vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+            pipeline->bind(commandBuffer);
+            scene.bind(commandBuffer, pipelineLayout, viewProjection);
+            scene.draw(commandBuffer);
+        }
+
+        lve::Device &lveDevice;
+        Target target;
+        lve::GpuScene layoutScene{lveDevice};  // only provides the descriptor set layout the pipeline is built against
+        VkPipelineLayout pipelineLayout{};
+        std::unique_ptr<lve::Pipeline> pipeline;
+        bool timestamps = false;
+        VkQueryPool queryPool{};
+    };
+}  // namespace
+
+int main() {
+    INIT_LOG()
+    try {
+        lve::Device device{};
+        if(!device.supportsDynamicRendering()) {
+            LWARN("occlusion_benchmark needs dynamic rendering, skipping");
+            return EXIT_SUCCESS;
+        }
+        Renderer renderer{device};
+        LINFO("{} buildings of {} triangles, {}x{}", citySide * citySide, C_ST(faceSubdivisions) * faceSubdivisions * 12, extent.width,
+              extent.height);
+        const Result all = renderer.run(Mode::All);
+        for(const Mode mode : {Mode::All, Mode::Frustum, Mode::Occlusion}) {
+            const Result result = mode == Mode::All ? all : renderer.run(mode);
+            LINFO("{:>9} | {:>5} draws | {:>10} triangles | gpu {:>12} | saved {:>12} ({:.1f}%)", toString(mode), result.draws,
+                  result.triangles, vnd::Timer::make_time_str(result.gpuNs), vnd::Timer::make_time_str(all.gpuNs - result.gpuNs),
+                  100.0L * (all.gpuNs - result.gpuNs) / std::max(all.gpuNs, 1.0L));
+        }
+        return EXIT_SUCCESS;
+    } catch(const std::exception &e) {
+        LERROR("Unhandled exception in occlusion_benchmark: {}", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+// NOLINTEND(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers, *-uppercase-literal-suffix)
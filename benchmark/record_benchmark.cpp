@@ -0,0 +1,130 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// CPU time to record N draws into secondary command buffers, split across 1 to 16 recording threads.
+// Nothing is submitted: only recording is measured, the frame pools are recycled with FrameContext::beginFrame.
+// NOLINTBEGIN(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers, *-uppercase-literal-suffix, *-pro-type-union-access)
+#include <vkl/FrameContext.hpp>
+#include <vkl/Model.hpp>
+#include <vkl/OffscreenTarget.hpp>
+#include <vkl/Pipeline.hpp>
+#include <vkl/Window.hpp>
+#include <vkl/timer/Timer.hpp>
+
+namespace {
+    constexpr std::size_t warmupFrames = 2;  // the first frames of each slot allocate their command buffers
+    constexpr std::size_t measuredFrames = 8;
+
+    struct Scene {
+        lve::Device &device;
+        lve::OffscreenTarget target;
+        VkPipelineLayout pipelineLayout{};
+        std::unique_ptr<lve::Pipeline> pipeline;
+        std::unique_ptr<lve::Model> model;
+
+        explicit Scene(lve::Device &dev) : device{dev}, target{dev, VkExtent2D{256, 256}} {
+            const std::array<lve::Model::Vertex, 3> vertices{lve::Model::Vertex{{0.0f, -0.5f, 0.0f}, {1.0f, 0.0f, 0.0f}},
+                                                             lve::Model::Vertex{{0.5f, 0.5f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+                                                             lve::Model::Vertex{{-0.5f, 0.5f, 0.0f}, {0.0f, 0.0f, 1.0f}}};
+            const std::array<uint32_t, 3> indices{0, 1, 2};
+            model = MAKE_UNIQUE(lve::Model, device, vertices, indices);
+
+            VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+            pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+            VK_CHECK(vkCreatePipelineLayout(device.device(), &pipelineLayoutInfo, nullptr, &pipelineLayout),
+                     "failed to create pipeline layout!");
+
+            lve::PipelineConfigInfo pipelineConfig{};
+            lve::Pipeline::defaultPipelineConfigInfo(pipelineConfig);
+            pipelineConfig.renderPass = target.getRenderPass();
+            pipelineConfig.pipelineLayout = pipelineLayout;
+            pipeline = MAKE_UNIQUE(
+                lve::Pipeline, device, lve::Window::calculateRelativePathToSrcShaders(curentP, "simple_shader.vert.opt.rmp.spv").string(),
+                lve::Window::calculateRelativePathToSrcShaders(curentP, "simple_shader.frag.opt.rmp.spv").string(), pipelineConfig);
+        }
+
+        ~Scene() {
+            model.reset();
+            pipeline.reset();
+            vkDestroyPipelineLayout(device.device(), pipelineLayout, nullptr);
+        }
+
+        Scene(const Scene &) = delete;
+        Scene &operator=(const Scene &) = delete;
+    };
+
+    void recordFrame(Scene &scene, lve::FrameContext &context, lve::ThreadPool &pool, std::size_t drawCount) {
+        VkCommandBuffer primary = context.commandBuffer();
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        VK_CHECK(vkBeginCommandBuffer(primary, &beginInfo), "failed to begin recording command buffer!");
+
+        std::array<VkClearValue, 2> clearValues{};
+        clearValues[0].color = VkClearColorValue{.float32{0.0f, 0.0f, 0.0f, 1.0f}};
+        clearValues[1].depthStencil = {.depth = 1.0f, .stencil = 0};
+        VkRenderPassBeginInfo renderPassInfo{};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassInfo.renderPass = scene.target.getRenderPass();
+        renderPassInfo.framebuffer = scene.target.getFrameBuffer(0);
+        renderPassInfo.renderArea.extent = scene.target.getSwapChainExtent();
+        renderPassInfo.clearValueCount = C_UI32T(clearValues.size());
+        renderPassInfo.pClearValues = clearValues.data();
+        vkCmdBeginRenderPass(primary, &renderPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+        VkCommandBufferInheritanceInfo inheritance{};
+        inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritance.renderPass = scene.target.getRenderPass();
+        inheritance.framebuffer = scene.target.getFrameBuffer(0);
+
+        const VkExtent2D extent = scene.target.getSwapChainExtent();
+        const auto recordChunk = [&](VkCommandBuffer cmd, std::size_t /*first*/, std::size_t count) {
+            const VkViewport viewport{0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f};
+            const VkRect2D scissor{.offset = {0, 0}, .extent = extent};
+            vkCmdSetViewport(cmd, 0, 1, &viewport);
+            vkCmdSetScissor(cmd, 0, 1, &scissor);
+            scene.pipeline->bind(cmd);
+            scene.model->bind(cmd);
+            for(std::size_t draw = 0; draw < count; draw++) { scene.model->draw(cmd); }
+        };
+        const auto secondaries = context.recordSecondary(pool, inheritance, drawCount, recordChunk);
+        vkCmdExecuteCommands(primary, C_UI32T(secondaries.size()), secondaries.data());
+
+        vkCmdEndRenderPass(primary);
+        VK_CHECK(vkEndCommandBuffer(primary), "failed to record command buffer!");
+    }
+
+    void runCase(Scene &scene, uint32_t threadCount, std::size_t drawCount) {
+        lve::ThreadPool pool{threadCount};
+        lve::FrameContext context{scene.device, lve::OffscreenTarget::MAX_FRAMES_IN_FLIGHT, threadCount};
+
+        long double measuredNs = 0;
+        for(std::size_t frame = 0; frame < warmupFrames + measuredFrames; frame++) {
+            context.beginFrame(frame);
+            const vnd::Timer timer{"record"};
+            recordFrame(scene, context, pool, drawCount);
+            if(frame >= warmupFrames) { measuredNs += timer.make_time(); }
+        }
+
+        const long double perFrameNs = measuredNs / C_LD(measuredFrames);
+        LINFO("{:>8} draws | {:>2} threads | {:>12} per frame | {:>8.2f} Mdraws/s", drawCount, threadCount,
+              vnd::Timer::make_time_str(perFrameNs), C_LD(drawCount) / (perFrameNs * 1e-9L) / 1e6L);
+    }
+}  // namespace
+
+int main() {
+    INIT_LOG()
+    try {
+        lve::Device device{};
+        Scene scene{device};
+        for(const std::size_t drawCount : {std::size_t{10'000}, std::size_t{100'000}, std::size_t{1'000'000}}) {
+            for(const uint32_t threadCount : {1U, 2U, 4U, 8U, 16U}) { runCase(scene, threadCount, drawCount); }
+        }
+    } catch(const std::exception &e) {
+        LERROR("Unhandled exception in record_benchmark: {}", e.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+// NOLINTEND(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers, *-uppercase-literal-suffix, *-pro-type-union-access)
@@ -0,0 +1,167 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// The street level city of occlusion_benchmark culled on the CPU with SoftwareOcclusion: the buildings are drawn as
+// occluders into the 256x128 depth buffer, then small props scattered over the streets are tested against it. Needs no
+// GPU. Exits with a failure when one thread and every hardware thread give different depth buffers or visibility, when
+// a prop in plain sight is culled, or when nothing at all is culled. The optional argument is the prop count; ctest runs
+// it with fewer props as the determinism check of SoftwareOcclusion.
+// NOLINTBEGIN(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers, *-uppercase-literal-suffix)
+#include <vkl/SoftwareOcclusion.hpp>
+#include <vkl/timer/Timer.hpp>
+
+namespace {
+    constexpr std::size_t warmupRuns = 3;
+    constexpr std::size_t measuredRuns = 20;
+    constexpr uint32_t citySide = 64;   // blocks per side
+    constexpr float blockSize = 12.0f;  // a building and its street
+    constexpr std::size_t defaultPropCount = 100'000;
+    constexpr std::size_t propsPerTask = 4096;
+
+    struct Box {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    struct City {
+        std::vector<glm::vec3> positions;  // unit box standing on y = 0
+        std::vector<uint32_t> indices;
+        std::vector<lve::SoftwareOcclusion::Occluder> occluders;
+        std::vector<Box> props;
+    };
+
+    City buildCity(std::size_t propCount) {
+        City city;
+        for(int corner = 0; corner < 8; corner++) {
+            city.positions.emplace_back(corner & 1 ? 0.5f : -0.5f, corner & 2 ? 1.0f : 0.0f, corner & 4 ? 0.5f : -0.5f);
+        }
+        city.indices = {0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6, 0, 1, 4, 1, 5, 4, 2, 6, 3, 3, 6, 7, 0, 4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5};
+
+        std::mt19937 random{7};
+        std::uniform_real_distribution<float> height{4.0f, 40.0f};
+        std::uniform_real_distribution<float> footprint{0.6f * blockSize, 0.8f * blockSize};
+        const float origin = -0.5f * blockSize * C_F(citySide);
+        for(uint32_t row = 0; row < citySide; row++) {
+            for(uint32_t column = 0; column < citySide; column++) {
+                const glm::vec3 position{origin + (C_F(column) + 0.5f) * blockSize, 0.0f, origin + (C_F(row) + 0.5f) * blockSize};
+                city.occluders.emplace_back(lve::SoftwareOcclusion::Occluder{
+                    .positions = city.positions,
+                    .indices = city.indices,
+                    .transform = glm::translate(glm::mat4{1.0f}, position) *
+                                 glm::scale(glm::mat4{1.0f}, glm::vec3{footprint(random), height(random), footprint(random)}),
+                });
+            }
+        }
+
+        // props along the street edges of every block, where the buildings do not hide them from above
+        std::uniform_int_distribution<uint32_t> block{0, citySide - 1};
+        std::uniform_real_distribution<float> edge{-0.5f, 0.5f};
+        std::uniform_real_distribution<float> size{0.3f, 1.5f};
+        for(std::size_t prop = 0; prop < propCount; prop++) {
+            const glm::vec3 center{origin + (C_F(block(random)) + 0.5f + 0.45f * edge(random)) * blockSize, 0.0f,
+                                   origin + (C_F(block(random)) + 0.5f + (prop % 2 == 0 ? 0.45f : -0.45f)) * blockSize};
+            const glm::vec3 extent{size(random), 2.0f * size(random), size(random)};
+            city.props.emplace_back(Box{center - glm::vec3{extent.x, 0.0f, extent.z}, center + extent});
+        }
+        return city;
+    }
+
+    // standing in the middle of a street, looking along it
+    glm::mat4 streetCamera(const lve::SoftwareOcclusion &occlusion) {
+        const float street = 0.5f * blockSize * C_F(citySide % 2);  // x of the street closest to the city center
+        const glm::mat4 view =
+            glm::lookAt(glm::vec3{street, 1.7f, 0.0f}, glm::vec3{street + 0.2f, 1.7f, 1.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+        glm::mat4 projection =
+            glm::perspectiveRH_ZO(glm::radians(70.0f), C_F(occlusion.width()) / C_F(occlusion.height()), 0.1f, 1000.0f);
+        projection[1][1] *= -1.0f;  // Vulkan clip space has y pointing down
+        return projection * view;
+    }
+
+    struct Result {
+        std::vector<float> depth;
+        std::vector<uint8_t> visible;
+        long double renderNs = 0;
+        long double testNs = 0;
+        std::size_t triangles = 0;
+    };
+
+    Result run(const City &city, lve::ThreadPool &pool) {
+        lve::SoftwareOcclusion occlusion;
+        const glm::mat4 viewProjection = streetCamera(occlusion);
+        Result result;
+        result.visible.resize(city.props.size());
+        for(std::size_t run = 0; run < warmupRuns + measuredRuns; run++) {
+            const vnd::Timer renderTimer{"render"};
+            occlusion.render(city.occluders, viewProjection, pool);
+            const long double renderNs = renderTimer.make_time();
+
+            const vnd::Timer testTimer{"test"};
+            pool.parallelFor((city.props.size() + propsPerTask - 1) / propsPerTask, [&](std::size_t task, uint32_t /*thread*/) {
+                const std::size_t last = std::min(city.props.size(), (task + 1) * propsPerTask);
+                for(std::size_t prop = task * propsPerTask; prop < last; prop++) {
+                    result.visible[prop] = occlusion.isVisible(city.props[prop].min, city.props[prop].max) ? 1 : 0;
+                }
+            });
+            const long double testNs = testTimer.make_time();
+            if(run >= warmupRuns) {
+                result.renderNs += renderNs / C_LD(measuredRuns);
+                result.testNs += testNs / C_LD(measuredRuns);
+            }
+        }
+        result.depth.assign(occlusion.depth().begin(), occlusion.depth().end());
+        result.triangles = occlusion.triangleCount();
+
+        // a prop on the street right in front of the camera can not be hidden
+        const float street = 0.5f * blockSize * C_F(citySide % 2);
+        if(!occlusion.isVisible(glm::vec3{street - 0.5f, 0.0f, 4.0f}, glm::vec3{street + 0.5f, 1.0f, 5.0f})) {
+            LERROR("a prop in plain sight was culled");
+            result.visible.clear();
+        }
+        return result;
+    }
+}  // namespace
+
+int main(int argc, const char *const argv[]) {
+    INIT_LOG()
+    try {
+        std::size_t propCount = defaultPropCount;
+        if(const std::span args(argv, C_ST(argc)); args.size() > 1) {
+            const std::string_view count{args[1]};
+            if(std::from_chars(count.data(), count.data() + count.size(), propCount).ec != std::errc{} || propCount == 0) {
+                LERROR("usage: software_occlusion_benchmark [prop count]");
+                return EXIT_FAILURE;
+            }
+        }
+        const City city = buildCity(propCount);
+        lve::ThreadPool singleThread{1};
+        lve::ThreadPool allThreads{};
+        const Result single = run(city, singleThread);
+        const Result pooled = run(city, allThreads);
+
+        const auto visibleCount = std::ranges::count(pooled.visible, uint8_t{1});
+        for(const auto &[threads, result] :
+            {std::pair{singleThread.threadCount(), &single}, std::pair{allThreads.threadCount(), &pooled}}) {
+            LINFO("{:>2} threads | {} occluders, {} triangles rasterized in {} | {} props tested in {}", threads, city.occluders.size(),
+                  result->triangles, vnd::Timer::make_time_str(result->renderNs), city.props.size(),
+                  vnd::Timer::make_time_str(result->testNs));
+        }
+        LINFO("{} of {} props visible, {:.1f}% culled", visibleCount, city.props.size(),
+              100.0 * C_D(city.props.size() - C_ST(visibleCount)) / C_D(city.props.size()));
+
+        // bit for bit: the depth buffer must not depend on how the tiles were spread over the threads
+        const bool sameDepth = single.depth.size() == pooled.depth.size() &&
+                               std::memcmp(single.depth.data(), pooled.depth.data(), single.depth.size() * sizeof(float)) == 0;
+        const bool valid = sameDepth && single.visible == pooled.visible && !pooled.visible.empty() &&
+                           C_ST(visibleCount) < city.props.size();
+        if(!valid) {
+            LERROR("software occlusion check failed: depth {}, visibility {}", sameDepth ? "matches" : "differs",
+                   single.visible == pooled.visible ? "matches" : "differs");
+        }
+        return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+    } catch(const std::exception &e) {
+        LERROR("Unhandled exception in software_occlusion_benchmark: {}", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+// NOLINTEND(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers, *-uppercase-literal-suffix)
@@ -0,0 +1,99 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// CPU frustum culling of N random bounding spheres with SphereCuller, on one thread and on every hardware thread,
+// against a plain loop over Frustum::intersectsSphere. The target is 1M spheres in under 1 ms on a desktop CPU. Exits
+// with a failure when the culled set differs from the reference by more than the rounding of spheres touching a plane.
+// NOLINTBEGIN(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers, *-uppercase-literal-suffix)
+#include <vkl/SphereCuller.hpp>
+#include <vkl/timer/Timer.hpp>
+
+namespace {
+    constexpr std::size_t warmupRuns = 3;
+    constexpr std::size_t measuredRuns = 20;
+    constexpr float sceneExtent = 200.0f;
+    constexpr long double targetNs = 1'000'000.0L;
+
+    long double timeCull(lve::SphereCuller &culler, const lve::BoundingSpheres &bounds, const lve::Frustum &frustum, lve::ThreadPool &pool,
+                         std::vector<uint32_t> &visible) {
+        long double totalNs = 0;
+        for(std::size_t run = 0; run < warmupRuns + measuredRuns; run++) {
+            const vnd::Timer timer{"sphere cull"};
+            const std::span<const uint32_t> result = culler.cull(bounds, frustum, pool);
+            const long double ns = timer.make_time();
+            if(run >= warmupRuns) { totalNs += ns; }
+            visible.assign(result.begin(), result.end());
+        }
+        return totalNs / C_LD(measuredRuns);
+    }
+
+    // the reference may round a sphere touching a plane the other way, anything further out is a real mismatch
+    bool onBoundary(const lve::Frustum &frustum, const glm::vec3 &center, float radius) {
+        return std::ranges::any_of(frustum.planes, [&](const glm::vec4 &plane) {
+            return std::abs(glm::dot(glm::vec3{plane}, center) + plane.w + radius) <= 1e-3f * std::max(1.0f, std::abs(plane.w));
+        });
+    }
+
+    bool runCase(std::size_t sphereCount, lve::ThreadPool &singleThread, lve::ThreadPool &allThreads) {
+        std::mt19937 random{42};
+        std::uniform_real_distribution<float> position{-sceneExtent, sceneExtent};
+        std::uniform_real_distribution<float> radius{0.5f, 5.0f};
+        lve::BoundingSpheres bounds;
+        bounds.reserve(sphereCount);
+        for(std::size_t sphere = 0; sphere < sphereCount; sphere++) {
+            bounds.add(glm::vec3{position(random), position(random), position(random)}, radius(random));
+        }
+
+        const glm::mat4 view = glm::lookAt(glm::vec3{0.0f}, glm::vec3{0.0f, 0.0f, -1.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+        const glm::mat4 projection = glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, sceneExtent * 0.75f);
+        const lve::Frustum frustum = lve::Frustum::fromViewProjection(projection * view);
+
+        lve::SphereCuller culler;
+        std::vector<uint32_t> visible;
+        const long double singleNs = timeCull(culler, bounds, frustum, singleThread, visible);
+        const long double pooledNs = timeCull(culler, bounds, frustum, allThreads, visible);
+
+        const vnd::Timer referenceTimer{"reference"};
+        std::vector<uint32_t> expected;
+        for(uint32_t sphere = 0; sphere < C_UI32T(sphereCount); sphere++) {
+            if(frustum.intersectsSphere(glm::vec3{bounds.x()[sphere], bounds.y()[sphere], bounds.z()[sphere]}, bounds.radius()[sphere])) {
+                expected.emplace_back(sphere);
+            }
+        }
+        const long double referenceNs = referenceTimer.make_time();
+
+        std::vector<uint32_t> differing;
+        std::ranges::set_symmetric_difference(visible, expected, std::back_inserter(differing));
+        const auto mismatches = std::ranges::count_if(differing, [&](uint32_t sphere) {
+            return !onBoundary(frustum, glm::vec3{bounds.x()[sphere], bounds.y()[sphere], bounds.z()[sphere]}, bounds.radius()[sphere]);
+        });
+
+        LINFO("{:>8} spheres | {:>7} visible | 1 thread {:>12} | {} threads {:>12} | scalar reference {:>12} | {}", sphereCount,
+              visible.size(), vnd::Timer::make_time_str(singleNs), allThreads.threadCount(), vnd::Timer::make_time_str(pooledNs),
+              vnd::Timer::make_time_str(referenceNs), mismatches == 0 ? "matches" : "MISMATCH");
+        if(sphereCount >= 1'000'000) {
+            LINFO("1 ms target for {} spheres {}", sphereCount, std::min(singleNs, pooledNs) < targetNs ? "met" : "missed");
+        }
+        if(mismatches != 0) { LERROR("{} spheres culled differently from the reference", mismatches); }
+        return mismatches == 0;
+    }
+}  // namespace
+
+int main() {
+    INIT_LOG()
+    try {
+        LINFO("SphereCuller kernel: {}", lve::SphereCuller::simd() ? "AVX2, 8 spheres per iteration" : "scalar");
+        lve::ThreadPool singleThread{1};
+        lve::ThreadPool allThreads{};
+        bool valid = true;
+        for(const std::size_t sphereCount : {std::size_t{1'000}, std::size_t{100'000}, std::size_t{1'000'000}, std::size_t{4'000'000}}) {
+            valid = runCase(sphereCount, singleThread, allThreads) && valid;
+        }
+        return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+    } catch(const std::exception &e) {
+        LERROR("Unhandled exception in sphere_cull_benchmark: {}", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+// NOLINTEND(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers, *-uppercase-literal-suffix)
@@ -0,0 +1,77 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// Upload throughput of N small staging copies, one submit per copy versus one batched submit.
+// NOLINTBEGIN(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers)
+#include <vkl/UploadEngine.hpp>
+#include <vkl/timer/Timer.hpp>
+
+namespace {
+    constexpr VkDeviceSize copySize = 1024;
+
+    struct Resources {
+        lve::Device &device;
+        VkBuffer staging{};
+        lve::Allocation stagingAllocation{};
+        std::vector<VkBuffer> targets;
+        std::vector<lve::Allocation> targetAllocations;
+
+        Resources(lve::Device &dev, std::size_t count) : device{dev}, targets(count), targetAllocations(count) {
+            device.createBuffer(copySize * count, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, staging, stagingAllocation);
+            std::memset(stagingAllocation.mapped, 0xAB, C_ST(copySize * count));
+            for(std::size_t i = 0; i < count; i++) {
+                device.createBuffer(copySize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, targets[i], targetAllocations[i]);
+            }
+        }
+
+        ~Resources() {
+            for(std::size_t i = 0; i < targets.size(); i++) { device.destroyBuffer(targets[i], targetAllocations[i]); }
+            device.destroyBuffer(staging, stagingAllocation);
+        }
+
+        Resources(const Resources &) = delete;
+        Resources &operator=(const Resources &) = delete;
+    };
+
+    long double megabytesPerSecond(std::size_t count, long double nanoseconds) {
+        return C_LD(copySize * count) / (nanoseconds * 1e-9L) / 1e6L;
+    }
+
+    void runCase(lve::Device &device, std::size_t count) {
+        const Resources resources{device, count};
+        auto &uploader = device.uploader();
+
+        const vnd::Timer single{"single"};
+        for(std::size_t i = 0; i < count; i++) {
+            uploader.wait(uploader.copyBuffer(resources.staging, resources.targets[i], copySize, copySize * i, 0));
+        }
+        const long double singleNs = single.make_time();
+
+        const vnd::Timer batched{"batched"};
+        auto batch = uploader.beginBatch();
+        for(std::size_t i = 0; i < count; i++) { batch.copyBuffer(resources.staging, resources.targets[i], copySize, copySize * i, 0); }
+        uploader.wait(uploader.flush(std::move(batch)));
+        const long double batchedNs = batched.make_time();
+
+        LINFO("{:>6} copies of {} B | per-copy submit: {:>10.2f} MB/s ({}) | batched: {:>10.2f} MB/s ({})", count, copySize,
+              megabytesPerSecond(count, singleNs), vnd::Timer::make_time_str(singleNs), megabytesPerSecond(count, batchedNs),
+              vnd::Timer::make_time_str(batchedNs));
+    }
+}  // namespace
+
+int main() {
+    INIT_LOG()
+    try {
+        lve::Device device{};
+        for(const std::size_t count : {std::size_t{1}, std::size_t{100}, std::size_t{10000}}) { runCase(device, count); }
+        device.allocator().logStats();
+    } catch(const std::exception &e) {
+        LERROR("Unhandled exception in upload_benchmark: {}", e.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+// NOLINTEND(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers)
@@ -0,0 +1,99 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "headers.hpp"
+
+#include <new>
+
+namespace lve {
+
+    /// std::allocator with a stronger alignment, for arrays loaded with aligned SIMD loads.
+    template <typename T, std::size_t Alignment> struct AlignedAllocator {
+        using value_type = T;
+
+        template <typename U> struct rebind {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+        // NOLINTNEXTLINE(*-explicit-constructor, *-explicit-conversions)
+        template <typename U> AlignedAllocator(const AlignedAllocator<U, Alignment> & /*other*/) noexcept {}
+
+        [[nodiscard]] T *allocate(std::size_t count) {
+            return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+        }
+        void deallocate(T *pointer, std::size_t count) noexcept {
+            ::operator delete(pointer, count * sizeof(T), std::align_val_t{Alignment});
+        }
+
+        bool operator==(const AlignedAllocator &other) const noexcept = default;
+    };
+
+    /**
+     * @brief World space bounding spheres stored as structure of arrays: x, y, z and radius each in their own array.
+     * The arrays are 32 byte aligned and padded to a multiple of LANES with spheres no frustum contains (radius -inf), so
+     * SIMD kernels load whole blocks of eight with aligned loads and need no scalar tail. Indices are stable, set()
+     * updates a sphere in place for moving objects.
+     */
+    class BoundingSpheres {
+    public:
+        static constexpr std::size_t LANES = 8;
+        static constexpr std::size_t ALIGNMENT = 32;
+        using Array = std::vector<float, AlignedAllocator<float, ALIGNMENT>>;
+
+        void reserve(std::size_t count) {
+            const std::size_t padded = blockCountFor(count) * LANES;
+            for(Array *array : {&x_, &y_, &z_, &radius_}) { array->reserve(padded); }
+        }
+
+        void clear() noexcept {
+            for(Array *array : {&x_, &y_, &z_, &radius_}) { array->clear(); }
+            size_ = 0;
+        }
+
+        /// Appends a sphere and returns its index.
+        uint32_t add(const glm::vec3 &center, float radius) {
+            if(size_ % LANES == 0) {
+                // open a new block of padding, later adds fill it in
+                x_.resize(x_.size() + LANES, 0.0f);
+                y_.resize(y_.size() + LANES, 0.0f);
+                z_.resize(z_.size() + LANES, 0.0f);
+                radius_.resize(radius_.size() + LANES, -std::numeric_limits<float>::infinity());
+            }
+            const auto index = C_UI32T(size_++);
+            set(index, center, radius);
+            return index;
+        }
+
+        void set(uint32_t index, const glm::vec3 &center, float radius) noexcept {
+            x_[index] = center.x;
+            y_[index] = center.y;
+            z_[index] = center.z;
+            radius_[index] = radius;
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+        [[nodiscard]] std::size_t blockCount() const noexcept { return x_.size() / LANES; }
+        [[nodiscard]] static constexpr std::size_t blockCountFor(std::size_t count) noexcept { return (count + LANES - 1) / LANES; }
+
+        /// blockCount() * LANES values each, the padding included.
+        [[nodiscard]] const float *x() const noexcept { return x_.data(); }
+        [[nodiscard]] const float *y() const noexcept { return y_.data(); }
+        [[nodiscard]] const float *z() const noexcept { return z_.data(); }
+        [[nodiscard]] const float *radius() const noexcept { return radius_.data(); }
+
+    private:
+        Array x_;
+        Array y_;
+        Array z_;
+        Array radius_;
+        std::size_t size_ = 0;
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
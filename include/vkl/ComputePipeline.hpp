@@ -0,0 +1,37 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "Device.hpp"
+
+namespace lve {
+
+    /**
+     * @brief Compute counterpart of Pipeline: one compute shader stage built against a caller owned layout.
+     * Goes through the device pipeline cache like the graphics pipelines. The shader module is only needed while the
+     * pipeline is created and is destroyed right after.
+     */
+    class ComputePipeline {
+    public:
+        ComputePipeline(Device &device, const std::string &compFilepath, VkPipelineLayout pipelineLayout);
+        ~ComputePipeline();
+
+        ComputePipeline(const ComputePipeline &) = delete;
+        ComputePipeline &operator=(const ComputePipeline &) = delete;
+
+        void bind(VkCommandBuffer commandBuffer) const;
+
+        /// Number of work groups of groupSize invocations needed to cover itemCount items.
+        [[nodiscard]] static constexpr uint32_t groupCount(uint32_t itemCount, uint32_t groupSize) noexcept {
+            return (itemCount + groupSize - 1) / groupSize;
+        }
+
+    private:
+        Device &lveDevice;
+        VkPipeline computePipeline{};
+    };
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
@@ -0,0 +1,63 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "ComputePipeline.hpp"
+
+namespace lve {
+
+    /**
+     * @brief Hierarchical Z buffer: a mip chain of R32_SFLOAT images reduced from a depth attachment with max.
+     * Level 0 is half the depth extent rounded up and each level halves the previous one, rounded down, to 1x1; a texel holds
+     * the farthest depth of the region it covers, so a box whose nearest depth is beyond it is hidden. depth_pyramid.comp
+     * reduces one level per dispatch. The pyramid stays in GENERAL layout, it is written by build() and sampled by
+     * OcclusionCuller. It references the depth view it was created with and has to be recreated along with it.
+     */
+    class DepthPyramid {
+    public:
+        static constexpr uint32_t GROUP_SIZE = 8;  // local_size_x and local_size_y of depth_pyramid.comp
+
+        DepthPyramid(Device &device, VkExtent2D depthExtent, VkImageView depthView);
+        ~DepthPyramid();
+
+        DepthPyramid(const DepthPyramid &) = delete;
+        DepthPyramid &operator=(const DepthPyramid &) = delete;
+
+        /**
+         * @brief Records the reduction of depthImage, in DEPTH_STENCIL_ATTACHMENT_OPTIMAL after a pass that stored it.
+         * The depth image is sampled in SHADER_READ_ONLY_OPTIMAL and returned to DEPTH_STENCIL_ATTACHMENT_OPTIMAL, so a
+         * following pass can load it; the pyramid is visible to compute shaders afterwards.
+         */
+        void build(VkCommandBuffer commandBuffer, VkImage depthImage, VkFormat depthFormat) const;
+
+        [[nodiscard]] VkImageView view() const noexcept { return fullView; }
+        [[nodiscard]] VkSampler sampler() const noexcept { return sampler_; }
+        [[nodiscard]] VkExtent2D depthExtent() const noexcept { return depthExtent_; }
+        [[nodiscard]] VkExtent2D extent() const noexcept { return extent_; }
+        [[nodiscard]] uint32_t levelCount() const noexcept { return C_UI32T(levelViews.size()); }
+
+    private:
+        void createImage();
+        void createDescriptors(VkImageView depthView);
+
+        Device &lveDevice;
+        VkExtent2D depthExtent_;
+        VkExtent2D extent_;
+        VkImage image{};
+        Allocation imageAllocation{};
+        VkImageView fullView{};
+        std::vector<VkImageView> levelViews;
+        VkSampler sampler_{};
+
+        VkDescriptorSetLayout setLayout{};
+        VkDescriptorPool descriptorPool{};
+        std::vector<VkDescriptorSet> levelSets;  // level i reads level i - 1, or the depth image for level 0
+        VkPipelineLayout pipelineLayout{};
+        std::unique_ptr<ComputePipeline> pipeline;
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "MemoryAllocator.hpp"
+#include "PipelineCache.hpp"
 #include "Window.hpp"
 
 // std lib headers
@@ -17,11 +19,29 @@ namespace lve {
     struct QueueFamilyIndices {
         uint32_t graphicsFamily;
         uint32_t presentFamily;
+        uint32_t transferFamily;  // dedicated transfer family when available, graphicsFamily otherwise
         bool graphicsFamilyHasValue = false;
         bool presentFamilyHasValue = false;
-        bool isComplete() { return graphicsFamilyHasValue && presentFamilyHasValue; }
+        bool transferFamilyHasValue = false;
+        bool isComplete(bool needsPresent = true) { return graphicsFamilyHasValue && (presentFamilyHasValue || !needsPresent); }
+        bool hasDedicatedTransfer() const { return transferFamilyHasValue && transferFamily != graphicsFamily; }
     };
 
+    /**
+     * @brief Ranking entry produced for every physical device when the device is picked.
+     */
+    struct DeviceCandidate {
+        VkPhysicalDevice device = VK_NULL_HANDLE;
+        uint32_t index = 0;  // enumeration order, usable as a selector
+        VkPhysicalDeviceProperties properties{};
+        std::array<uint8_t, VK_UUID_SIZE> deviceUUID{};
+        VkDeviceSize deviceLocalBytes = 0;  // size of the largest device local heap
+        bool suitable = false;
+        uint64_t score = 0;
+    };
+
+    class UploadEngine;
+
     class Device {
     public:
 #ifdef NDEBUG
@@ -31,8 +51,17 @@ namespace lve {
 #endif
 
         Device(Window &window);
+        /// Headless device: no window, no surface, no swapchain extension and no present queue (see OffscreenTarget).
+        Device();
         ~Device();
 
+        /**
+         * @brief Forces the physical device picked by the next Device, bypassing the scoring.
+         * The selector is either the enumeration index, the deviceUUID or pipelineCacheUUID in hex (dashes optional)
+         * or a case insensitive substring of the device name. When empty the VKL_DEVICE environment variable is used.
+         */
+        static void setDeviceSelector(std::string_view selector) { deviceSelector = selector; }
+
         // Not copyable or movable
         Device(const Device &) = delete;
         void operator=(const Device &) = delete;
@@ -43,7 +72,22 @@ namespace lve {
         VkDevice device() { return device_; }
         VkSurfaceKHR surface() { return surface_; }
         VkQueue graphicsQueue() { return graphicsQueue_; }
-        VkQueue presentQueue() { return presentQueue_; }
+        VkQueue presentQueue() { return presentQueue_; }  // VK_NULL_HANDLE when headless
+        VkQueue transferQueue() { return transferQueue_; }
+        UploadEngine &uploader() { return *uploader_; }
+        MemoryAllocator &allocator() { return *allocator_; }
+        PipelineCache &pipelineCache() { return *pipelineCache_; }
+        [[nodiscard]] bool isHeadless() const noexcept { return window == nullptr; }
+        /// True when the dynamicRendering feature was enabled (Vulkan 1.3 device that supports it).
+        [[nodiscard]] bool supportsDynamicRendering() const noexcept { return dynamicRendering_; }
+        /// True when one vkCmdDrawIndexedIndirect may consume more than one command.
+        [[nodiscard]] bool supportsMultiDrawIndirect() const noexcept { return multiDrawIndirect_; }
+        /// True when indirect commands may use a non zero firstInstance.
+        [[nodiscard]] bool supportsDrawIndirectFirstInstance() const noexcept { return drawIndirectFirstInstance_; }
+        /// True when the draw count of vkCmdDrawIndexedIndirectCount can be sourced from a buffer (Vulkan 1.2 feature).
+        [[nodiscard]] bool supportsDrawIndirectCount() const noexcept { return drawIndirectCount_; }
+        /// True when VkPipelineCreationFeedbackCreateInfo may be chained to pipeline creation (Vulkan 1.3 device).
+        [[nodiscard]] bool supportsPipelineCreationFeedback() const noexcept { return pipelineCreationFeedback_; }
 
         SwapChainSupportDetails getSwapChainSupport() { return querySwapChainSupport(physicalDevice); }
         uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags dproperties);
@@ -52,27 +96,34 @@ namespace lve {
 
         // Buffer Helper Functions
         void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags dproperties, VkBuffer &buffer,
-                          VkDeviceMemory &bufferMemory);
+                          Allocation &bufferAllocation);
+        void destroyBuffer(VkBuffer &buffer, Allocation &bufferAllocation);
         VkCommandBuffer beginSingleTimeCommands();
         void endSingleTimeCommands(VkCommandBuffer commandBuffer);
         void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
         void copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height, uint32_t layerCount);
 
         void createImageWithInfo(const VkImageCreateInfo &imageInfo, VkMemoryPropertyFlags dproperties, VkImage &image,
-                                 VkDeviceMemory &imageMemory);
+                                 Allocation &imageAllocation, VkMemoryPropertyFlags preferred = 0);
+        void destroyImage(VkImage &image, Allocation &imageAllocation);
 
         VkPhysicalDeviceProperties properties{};
 
     private:
+        explicit Device(Window *windowPtr);
+
         void createInstance();
         void setupDebugMessenger();
         void createSurface();
         void pickPhysicalDevice();
         void createLogicalDevice();
+        void createAllocator();
+        void createPipelineCache();
         void createCommandPool();
 
         // helper functions
         bool isDeviceSuitable(VkPhysicalDevice device);
+        DeviceCandidate rateDevice(VkPhysicalDevice device, uint32_t index);
         std::vector<const char *> getRequiredExtensions();
         bool checkValidationLayerSupport();
         QueueFamilyIndices findQueueFamilies(VkPhysicalDevice device);
@@ -84,16 +135,31 @@ namespace lve {
         VkInstance instance{};
         VkDebugUtilsMessengerEXT debugMessenger;
         VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
-        Window &window;
+        Window *window;
         VkCommandPool commandPool{};
+        std::unique_ptr<MemoryAllocator> allocator_;
+        std::unique_ptr<PipelineCache> pipelineCache_;
+        std::unique_ptr<UploadEngine> uploader_;
 
         VkDevice device_{};
         VkSurfaceKHR surface_{};
         VkQueue graphicsQueue_{};
         VkQueue presentQueue_{};
+        VkQueue transferQueue_{};
+        bool dynamicRendering_ = false;
+        bool multiDrawIndirect_ = false;
+        bool drawIndirectFirstInstance_ = false;
+        bool drawIndirectCount_ = false;
+        bool pipelineCreationFeedback_ = false;
 
         const std::vector<const char *> validationLayers = {"VK_LAYER_KHRONOS_validation"};
-        const std::vector<const char *> deviceExtensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
+        const std::vector<const char *> deviceExtensions;  // VK_KHR_swapchain unless headless
+        // not required, every one supported adds to the device score
+        const std::vector<const char *> optionalDeviceExtensions = {VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
+                                                                    VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME,
+                                                                    VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME};
+
+        static inline std::string deviceSelector;
     };
 
 }  // namespace lve
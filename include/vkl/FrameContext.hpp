@@ -0,0 +1,71 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "Device.hpp"
+#include "ThreadPool.hpp"
+
+namespace lve {
+
+    /**
+     * @brief Command buffers of every frame in flight, one command pool per frame slot per recording thread.
+     * beginFrame() resets all the pools of a slot at once with vkResetCommandPool, so it must only be called once the
+     * last frame recorded in that slot has retired (i.e. after SwapChain::acquireNextImage). Command buffers are
+     * allocated the first time a slot needs that many and recycled afterwards: the frame loop re-records every frame
+     * without allocating or freeing anything. A thread index may only be used by one thread at a time.
+     */
+    class FrameContext {
+    public:
+        FrameContext(Device &device, std::size_t frameCount, uint32_t threadCount = 1);
+        ~FrameContext();
+
+        FrameContext(const FrameContext &) = delete;
+        FrameContext &operator=(const FrameContext &) = delete;
+
+        void beginFrame(std::size_t frameIndex);
+        /// Next unused command buffer of the current frame for the given recording thread, ready for vkBeginCommandBuffer.
+        [[nodiscard]] VkCommandBuffer commandBuffer(uint32_t thread = 0, VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
+        using ChunkRecorder = std::function<void(VkCommandBuffer secondary, std::size_t first, std::size_t count)>;
+        static constexpr std::size_t MIN_ITEMS_PER_CHUNK = 256;
+        static constexpr std::size_t CHUNKS_PER_THREAD = 4;  // more chunks than threads evens out uneven chunks
+
+        /**
+         * @brief Records [0, itemCount) split in chunks into secondary command buffers on the threads of pool.
+         * Each chunk gets its own secondary buffer, begun with RENDER_PASS_CONTINUE and the given inheritance and
+         * allocated from the pool of the thread that records it, so recordChunk only records the draws (plus any
+         * dynamic state, which is not inherited). Returns the buffers in chunk order, ready for vkCmdExecuteCommands;
+         * they stay valid until the next recordSecondary() or beginFrame(). pool must not have more threads than this.
+         */
+        [[nodiscard]] std::span<const VkCommandBuffer> recordSecondary(ThreadPool &pool, const VkCommandBufferInheritanceInfo &inheritance,
+                                                                       std::size_t itemCount, const ChunkRecorder &recordChunk);
+
+        [[nodiscard]] std::size_t frameIndex() const noexcept { return frameIndex_; }
+        [[nodiscard]] std::size_t frameCount() const noexcept { return frameCount_; }
+        [[nodiscard]] uint32_t threadCount() const noexcept { return threadCount_; }
+
+    private:
+        // aligned so that threads recording side by side never share a cache line
+        struct alignas(64) ThreadCommands {
+            VkCommandPool pool = VK_NULL_HANDLE;
+            std::vector<VkCommandBuffer> primary;
+            std::vector<VkCommandBuffer> secondary;
+            std::size_t primaryUsed = 0;
+            std::size_t secondaryUsed = 0;
+        };
+
+        [[nodiscard]] ThreadCommands &poolOf(std::size_t frame, uint32_t thread) noexcept { return pools[frame * threadCount_ + thread]; }
+
+        Device &lveDevice;
+        std::size_t frameCount_;
+        uint32_t threadCount_;
+        std::size_t frameIndex_ = 0;
+        std::vector<ThreadCommands> pools;  // frame major
+        std::vector<VkCommandBuffer> secondaries;
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
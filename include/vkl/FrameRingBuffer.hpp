@@ -0,0 +1,67 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "Device.hpp"
+
+namespace lve {
+
+    /**
+     * @brief Sub-range of a FrameRingBuffer valid for the current frame only.
+     */
+    struct RingAllocation {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+        VkDeviceSize size = 0;
+        void *data = nullptr;
+
+        template <typename T> [[nodiscard]] T *as() const noexcept { return static_cast<T *>(data); }
+        [[nodiscard]] VkDescriptorBufferInfo descriptorInfo() const noexcept { return {buffer, offset, size}; }
+    };
+
+    /**
+     * @brief Host visible, persistently mapped buffer split in one region per frame in flight.
+     * The region of a frame slot is recycled by beginFrame(), which must only be called once the last frame recorded in
+     * that slot has retired (i.e. after SwapChain::acquireNextImage). Allocations are a bump of the region head: no copies,
+     * no Vulkan calls in the hot path.
+     */
+    class FrameRingBuffer {
+    public:
+        FrameRingBuffer(Device &device, VkDeviceSize bytesPerFrame, std::size_t frameCount,
+                        VkBufferUsageFlags usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                                   VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+        ~FrameRingBuffer();
+
+        FrameRingBuffer(const FrameRingBuffer &) = delete;
+        FrameRingBuffer &operator=(const FrameRingBuffer &) = delete;
+
+        void beginFrame(std::size_t frameIndex) noexcept;
+        [[nodiscard]] RingAllocation allocate(VkDeviceSize size, VkDeviceSize alignment = 0);
+
+        template <typename T> [[nodiscard]] RingAllocation push(const T &value) {
+            static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can be pushed to the GPU");
+            const RingAllocation allocation = allocate(sizeof(T));
+            std::memcpy(allocation.data, &value, sizeof(T));
+            return allocation;
+        }
+
+        [[nodiscard]] VkBuffer getBuffer() const noexcept { return buffer; }
+        [[nodiscard]] VkDeviceSize regionSize() const noexcept { return regionSize_; }
+        [[nodiscard]] VkDeviceSize bytesUsed() const noexcept { return head; }
+
+    private:
+        Device &lveDevice;
+        VkBuffer buffer{};
+        Allocation allocation{};
+        VkDeviceSize regionSize_;
+        std::size_t frameCount_;
+        VkDeviceSize minAlignment;
+        VkDeviceSize regionBase = 0;
+        VkDeviceSize head = 0;
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
@@ -0,0 +1,53 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "headers.hpp"
+
+namespace lve {
+
+    /**
+     * @brief The six planes of a view frustum, normals pointing inwards and normalized.
+     * Extracted from a view projection matrix with the Vulkan clip volume (-w <= x, y <= w and 0 <= z <= w); a point p is
+     * inside a plane when dot(plane.xyz, p) + plane.w >= 0. The tests are conservative: they never reject a visible
+     * volume but keep some that are only near a corner. cull.comp implements the same tests.
+     */
+    struct Frustum {
+        enum Plane : uint8_t { Left, Right, Bottom, Top, Near, Far };
+
+        std::array<glm::vec4, 6> planes{};
+
+        [[nodiscard]] static Frustum fromViewProjection(const glm::mat4 &viewProjection) noexcept {
+            const auto row = [&viewProjection](int index) {
+                return glm::vec4{viewProjection[0][index], viewProjection[1][index], viewProjection[2][index], viewProjection[3][index]};
+            };
+            Frustum frustum;
+            frustum.planes[Left] = row(3) + row(0);
+            frustum.planes[Right] = row(3) - row(0);
+            frustum.planes[Bottom] = row(3) + row(1);
+            frustum.planes[Top] = row(3) - row(1);
+            frustum.planes[Near] = row(2);
+            frustum.planes[Far] = row(3) - row(2);
+            for(glm::vec4 &plane : frustum.planes) { plane /= glm::length(glm::vec3{plane}); }
+            return frustum;
+        }
+
+        [[nodiscard]] bool intersectsSphere(const glm::vec3 &center, float radius) const noexcept {
+            return std::ranges::all_of(planes,
+                                       [&](const glm::vec4 &plane) { return glm::dot(glm::vec3{plane}, center) + plane.w >= -radius; });
+        }
+
+        /// Box given by its center and half extents.
+        [[nodiscard]] bool intersectsBox(const glm::vec3 &center, const glm::vec3 &extent) const noexcept {
+            return std::ranges::all_of(planes, [&](const glm::vec4 &plane) {
+                const glm::vec3 normal{plane};
+                return glm::dot(normal, center) + plane.w + glm::dot(glm::abs(normal), extent) >= 0.0f;
+            });
+        }
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
@@ -0,0 +1,67 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "ComputePipeline.hpp"
+#include "Frustum.hpp"
+#include "GpuScene.hpp"
+
+namespace lve {
+
+    /**
+     * @brief Compute pass culling the objects of a GpuScene against a frustum before they are drawn.
+     * cull.comp tests the bounding sphere and box of every object and appends the draws of the survivors to the
+     * scene's indirect buffer with an atomic counter in its draw count buffer, so GpuScene::draw only processes visible
+     * objects. The count is also copied to a host visible slot per frame in flight and read back once that frame
+     * retired, so the stats never stall the GPU. When the scene draws without a count the command buffer is zeroed first, leaving
+     * the culled tail as empty draws. The scene must be built before the culler is created and outlive it.
+     */
+    class GpuCuller {
+    public:
+        static constexpr uint32_t GROUP_SIZE = 64;  // local_size_x of cull.comp
+
+        struct Stats {
+            uint32_t visible = 0;
+            uint32_t culled = 0;
+
+            bool operator==(const Stats &other) const noexcept = default;
+        };
+
+        GpuCuller(Device &device, const GpuScene &scene, std::size_t framesInFlight);
+        ~GpuCuller();
+
+        GpuCuller(const GpuCuller &) = delete;
+        GpuCuller &operator=(const GpuCuller &) = delete;
+
+        /// Records the pass for frame slot frameIndex; outside of any render pass and before the scene is drawn.
+        void record(VkCommandBuffer commandBuffer, std::size_t frameIndex, const Frustum &frustum);
+        /// Result of the last pass recorded in frameIndex, which must have retired; empty before the first one.
+        [[nodiscard]] std::optional<Stats> stats(std::size_t frameIndex) const;
+
+    private:
+        struct PushConstants {
+            std::array<glm::vec4, 6> planes;
+            uint32_t objectCount;
+        };
+
+        void createDescriptors();
+        void createPipelineLayout();
+
+        Device &lveDevice;
+        const GpuScene &scene;
+        VkDescriptorSetLayout setLayout{};
+        VkDescriptorPool descriptorPool{};
+        VkDescriptorSet descriptorSet{};
+        VkPipelineLayout pipelineLayout{};
+        std::unique_ptr<ComputePipeline> pipeline;
+
+        VkBuffer readbackBuffer{};
+        Allocation readbackAllocation{};
+        std::vector<uint32_t> slotObjects;  // objects culled by the last pass of each slot, 0 before the first
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
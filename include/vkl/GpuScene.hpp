@@ -0,0 +1,122 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "Model.hpp"
+
+namespace lve {
+
+    /**
+     * @brief GPU driven scene: every mesh in one vertex and one index buffer, every object in a storage buffer and one
+     * VkDrawIndexedIndirectCommand per object.
+     * Objects reference meshes by ID; the indirect command of object i uses firstInstance = i so that the vertex shader
+     * reads its ObjectData with gl_InstanceIndex. Recording a frame is one bind and one vkCmdDrawIndexedIndirectCount
+     * whatever the object count, the draw count comes from a buffer so that a compute pass can compact the commands.
+     * Without drawIndirectCount or multiDrawIndirect the commands are consumed with vkCmdDrawIndexedIndirect, one call
+     * per object when multiDrawIndirect is missing. The objects and meshes are also exposed as storage buffers for GpuCuller.
+     */
+    class GpuScene {
+    public:
+        /// std430 mirror of ObjectData in scene_shader.vert.
+        struct ObjectData {
+            glm::mat4 transform{1.0f};
+            uint32_t meshId = 0;
+            uint32_t materialId = 0;
+            std::array<uint32_t, 2> padding{};
+        };
+        static_assert(sizeof(ObjectData) == 80);
+
+        /// std430 mirror of MeshInfo in cull.comp: object space bounds and the draw arguments of one mesh.
+        struct MeshInfo {
+            glm::vec4 sphere{};  // center, radius
+            glm::vec4 boxMin{};
+            glm::vec4 boxMax{};
+            uint32_t firstIndex = 0;
+            uint32_t indexCount = 0;
+            int32_t vertexOffset = 0;
+            uint32_t padding = 0;
+        };
+        static_assert(sizeof(MeshInfo) == 64);
+
+        /// Where a mesh lives inside the shared buffers.
+        struct MeshRange {
+            uint32_t firstIndex = 0;
+            uint32_t indexCount = 0;
+            int32_t vertexOffset = 0;
+            uint32_t vertexCount = 0;
+            Model::Bounds bounds{};
+        };
+
+        static constexpr uint32_t OBJECT_BINDING = 0;
+        /// Push constant range of scene_shader.vert holding the view projection matrix, for the pipeline layout.
+        static constexpr VkPushConstantRange CAMERA_PUSH_CONSTANTS{
+            .stageFlags = VK_SHADER_STAGE_VERTEX_BIT, .offset = 0, .size = sizeof(glm::mat4)};
+
+        explicit GpuScene(Device &device);
+        ~GpuScene();
+
+        GpuScene(const GpuScene &) = delete;
+        GpuScene &operator=(const GpuScene &) = delete;
+        GpuScene(GpuScene &&) = delete;
+        GpuScene &operator=(GpuScene &&) = delete;
+
+        /// Appends the mesh to the shared buffers and returns its ID. Takes effect at the next build().
+        uint32_t addMesh(const MeshData &mesh);
+        /// Adds an instance of meshId and returns its object index. Takes effect at the next build().
+        uint32_t addObject(const glm::mat4 &transform, uint32_t meshId, uint32_t materialId = 0);
+        /**
+         * @brief Uploads meshes, objects and draw commands to DEVICE_LOCAL buffers and waits for the copy.
+         * May be called again after adding more; the caller makes sure the GPU no longer uses the previous buffers.
+         */
+        void build();
+
+        /// Binds the shared vertex and index buffers, the object set as set 0 of pipelineLayout and the camera.
+        void bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, const glm::mat4 &viewProjection = glm::mat4{1.0f}) const;
+        void draw(VkCommandBuffer commandBuffer) const;
+
+        [[nodiscard]] VkDescriptorSetLayout descriptorSetLayout() const noexcept { return setLayout; }
+        [[nodiscard]] uint32_t meshCount() const noexcept { return C_UI32T(meshes.size()); }
+        [[nodiscard]] uint32_t objectCount() const noexcept { return C_UI32T(objects.size()); }
+        [[nodiscard]] const MeshRange &mesh(uint32_t meshId) const { return meshes.at(meshId); }
+        [[nodiscard]] std::span<const ObjectData> objectData() const noexcept { return objects; }
+        [[nodiscard]] VkBuffer objectBuffer() const noexcept { return objectBuffer_; }
+        [[nodiscard]] VkBuffer meshBuffer() const noexcept { return meshBuffer_; }
+        [[nodiscard]] VkBuffer drawCommandBuffer() const noexcept { return drawBuffer; }
+        [[nodiscard]] VkBuffer drawCountBuffer() const noexcept { return countBuffer; }
+        /// Whether draw() reads the count buffer; otherwise every command is drawn and culled ones must have instanceCount 0.
+        [[nodiscard]] bool drawsWithCount() const noexcept;
+
+    private:
+        void createDescriptors();
+        void destroyBuffers();
+
+        Device &lveDevice;
+        std::vector<Model::Vertex> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<MeshRange> meshes;
+        std::vector<ObjectData> objects;
+        uint32_t builtObjects = 0;
+
+        VkBuffer vertexBuffer{};
+        Allocation vertexAllocation{};
+        VkBuffer indexBuffer{};
+        Allocation indexAllocation{};
+        VkBuffer objectBuffer_{};
+        Allocation objectAllocation{};
+        VkBuffer meshBuffer_{};
+        Allocation meshAllocation{};
+        VkBuffer drawBuffer{};
+        Allocation drawAllocation{};
+        VkBuffer countBuffer{};
+        Allocation countAllocation{};
+
+        VkDescriptorSetLayout setLayout{};
+        VkDescriptorPool descriptorPool{};
+        VkDescriptorSet descriptorSet{};
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
@@ -0,0 +1,48 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+#include "FrameContext.hpp"
+#include "FrameRingBuffer.hpp"
+#include "OffscreenTarget.hpp"
+#include "Pipeline.hpp"
+
+namespace lve {
+
+    /**
+     * @brief Frame loop of App running on a headless Device and an OffscreenTarget.
+     * Nothing is presented, so frames are only limited by the GPU and by recording, which happens every frame as in
+     * App; run() renders a fixed number of frames and logs the frame rate, which makes it usable on machines without a
+     * display and in CI.
+     */
+    class HeadlessApp {
+    public:
+        static constexpr VkDeviceSize FRAME_RING_SIZE = VkDeviceSize{4} * 1024 * 1024;
+
+        HeadlessApp();
+        ~HeadlessApp();
+
+        HeadlessApp(const HeadlessApp &) = delete;
+        HeadlessApp &operator=(const HeadlessApp &) = delete;
+
+        void run(std::size_t frameCount);
+
+    private:
+        void loadModels();
+        void createPipelineLayout();
+        void createPipeline();
+        void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+        void drawFrame();
+
+        Device lveDevice{};
+        OffscreenTarget lveTarget{lveDevice, VkExtent2D{C_UI32T(WWIDTH), C_UI32T(WHEIGHT)}};
+        FrameRingBuffer frameRing{lveDevice, FRAME_RING_SIZE, OffscreenTarget::MAX_FRAMES_IN_FLIGHT};
+        FrameContext frameContext{lveDevice, OffscreenTarget::MAX_FRAMES_IN_FLIGHT};
+        std::unique_ptr<Model> lveModel;
+        std::unique_ptr<Pipeline> lvePipeline;
+        VkPipelineLayout pipelineLayout{};
+    };
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
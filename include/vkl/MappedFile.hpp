@@ -0,0 +1,46 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "headers.hpp"
+
+namespace lve {
+
+    /**
+     * @brief Read-only memory mapping of a whole file.
+     * The pages are only faulted in when touched, so parsers can work on the file in place from several threads
+     * without reading it into a buffer first. An empty file maps to an empty view.
+     */
+    class MappedFile {
+    public:
+        explicit MappedFile(const fs::path &path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+        MappedFile(MappedFile &&other) noexcept;
+        MappedFile &operator=(MappedFile &&other) noexcept;
+
+        [[nodiscard]] const char *data() const noexcept { return data_; }
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+        [[nodiscard]] std::string_view view() const noexcept { return {data_, size_}; }
+        [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return std::as_bytes(std::span{data_, size_}); }
+        [[nodiscard]] const fs::path &path() const noexcept { return path_; }
+
+    private:
+        void unmap() noexcept;
+
+        fs::path path_;
+        const char *data_ = nullptr;
+        std::size_t size_ = 0;
+#ifdef _WIN32
+        void *file = nullptr;
+        void *mapping = nullptr;
+#endif
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
@@ -0,0 +1,113 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "vulkanCheck.hpp"
+
+#include <mutex>
+
+namespace lve {
+
+    /**
+     * @brief Kind of resource bound to an allocation.
+     * Linear (buffers) and optimal (images) resources are kept in separate blocks when the device reports a
+     * bufferImageGranularity larger than the smallest sub-allocation, so they can never share a granularity page.
+     */
+    enum class ResourceKind : uint8_t { Linear = 0, Optimal = 1 };
+
+    /**
+     * @brief Lightweight handle to a sub-range of a VkDeviceMemory block.
+     */
+    struct Allocation {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+        VkDeviceSize size = 0;
+        void *mapped = nullptr;  // persistent mapping of offset, nullptr when the memory is not host coherent
+        uint32_t pool = MAXU32;  // MAXU32 for dedicated allocations
+        uint32_t block = 0;
+        uint32_t order = 0;  // buddy order of the reserved range
+
+        [[nodiscard]] bool isValid() const noexcept { return memory != VK_NULL_HANDLE; }
+        [[nodiscard]] bool isDedicated() const noexcept { return pool == MAXU32; }
+    };
+
+    struct AllocatorStats {
+        std::size_t blockCount = 0;
+        std::size_t dedicatedCount = 0;
+        std::size_t allocationCount = 0;
+        VkDeviceSize reservedBytes = 0;
+        VkDeviceSize usedBytes = 0;
+    };
+
+    /**
+     * @brief Block based device memory allocator.
+     * Every memory type owns a list of large VkDeviceMemory blocks that are carved up with a buddy allocator,
+     * so thousands of resources cost only a handful of real vkAllocateMemory calls. Requests larger than half a
+     * block fall back to a dedicated allocation. Host visible requests always get host coherent memory, which is
+     * persistently mapped, so writes through Allocation::mapped never need a flush or an invalidate.
+     */
+    class MemoryAllocator {
+    public:
+        static constexpr VkDeviceSize MIN_ALLOCATION_SIZE = 256;
+        static constexpr VkDeviceSize DEFAULT_BLOCK_SIZE = VkDeviceSize{64} * 1024 * 1024;
+
+        MemoryAllocator(VkPhysicalDevice physicalDevice, VkDevice device, VkDeviceSize bufferImageGranularity,
+                        VkDeviceSize preferredBlockSize = DEFAULT_BLOCK_SIZE);
+        ~MemoryAllocator();
+
+        MemoryAllocator(const MemoryAllocator &) = delete;
+        MemoryAllocator &operator=(const MemoryAllocator &) = delete;
+        MemoryAllocator(MemoryAllocator &&) = delete;
+        MemoryAllocator &operator=(MemoryAllocator &&) = delete;
+
+        /// preferred flags are tried on top of the required ones first, e.g. LAZILY_ALLOCATED for transient attachments.
+        [[nodiscard]] Allocation allocate(const VkMemoryRequirements &requirements, VkMemoryPropertyFlags properties, ResourceKind kind,
+                                          VkMemoryPropertyFlags preferred = 0);
+        void free(Allocation &allocation);
+
+        [[nodiscard]] uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+        [[nodiscard]] std::optional<uint32_t> tryFindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const noexcept;
+        [[nodiscard]] const VkPhysicalDeviceMemoryProperties &memoryProperties() const noexcept { return memProperties; }
+        [[nodiscard]] AllocatorStats stats() const;
+        void logStats() const;
+
+    private:
+        struct Block {
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+            void *mapped = nullptr;
+            std::vector<std::set<VkDeviceSize>> freeLists;  // free offsets indexed by buddy order
+            std::size_t allocationCount = 0;
+            VkDeviceSize usedBytes = 0;
+        };
+
+        struct Pool {
+            uint32_t memoryTypeIndex = 0;
+            VkDeviceSize blockSize = 0;
+            uint32_t maxOrder = 0;
+            std::vector<Block> blocks;
+        };
+
+        [[nodiscard]] static uint32_t orderFor(VkDeviceSize size) noexcept;
+        [[nodiscard]] static VkDeviceSize orderSize(uint32_t order) noexcept { return MIN_ALLOCATION_SIZE << order; }
+        [[nodiscard]] bool isHostCoherent(uint32_t memoryTypeIndex) const noexcept;
+        [[nodiscard]] VkDeviceMemory allocateMemory(VkDeviceSize size, uint32_t memoryTypeIndex, void **mapped);
+        [[nodiscard]] Allocation allocateDedicated(VkDeviceSize size, uint32_t memoryTypeIndex);
+        [[nodiscard]] std::optional<VkDeviceSize> allocateFromBlock(Block &block, uint32_t order, uint32_t maxOrder);
+        void freeToBlock(Block &block, VkDeviceSize offset, uint32_t order, uint32_t maxOrder);
+        Block &createBlock(Pool &pool);
+
+        VkDevice device_;
+        VkPhysicalDeviceMemoryProperties memProperties{};
+        VkDeviceSize preferredBlockSize_;
+        bool separateResourceKinds;
+        std::vector<Pool> pools;  // indexed by memoryTypeIndex * 2 + kind
+        std::size_t dedicatedCount = 0;
+        VkDeviceSize dedicatedBytes = 0;
+        mutable std::mutex mutex;
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
@@ -0,0 +1,86 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "Model.hpp"
+#include "ThreadPool.hpp"
+
+namespace lve {
+
+    /**
+     * @brief On disk cache of parsed meshes in a memory mappable binary format.
+     * A cache file is a versioned header followed by the vertex and index blobs, each aligned to BLOB_ALIGNMENT. The
+     * header describes the vertex layout the blobs were written with, the index type, the bounds of the mesh, and the
+     * size, mtime and FNV-1a hash of the source file. Meshes go through MeshOptimizer before being written, so the
+     * optimization is paid once per source. On a hit the file is mapped and the blobs are copied straight
+     * into the staging buffer of the Model, no parsing nor intermediate copy involved. A source whose mtime changed
+     * but whose content hash still matches is kept and the new mtime is written back, so only the first load after a
+     * copy or checkout hashes the source; a changed vertex layout, version or source rebuilds the entry.
+     */
+    class MeshCache {
+    public:
+        static constexpr uint32_t VERSION = 2;  // 2: blobs are stored in MeshOptimizer order
+        static constexpr std::size_t BLOB_ALIGNMENT = 64;
+        static constexpr std::size_t MAX_ATTRIBUTES = 8;
+
+        explicit MeshCache(fs::path directory = defaultDirectory());
+
+        /// Model of an OBJ file, served from the cache when it is fresh, otherwise parsed, optimized and written to the cache.
+        /// Each vertex format has its own entry, quantized ones store the packed vertices.
+        [[nodiscard]] std::unique_ptr<Model> loadObj(Device &device, const fs::path &source, ThreadPool &pool,
+                                                     VertexFormat format = VertexFormat::Float) const;
+        [[nodiscard]] fs::path cachePathOf(const fs::path &source, VertexFormat format = VertexFormat::Float) const;
+        [[nodiscard]] const fs::path &directory() const noexcept { return directory_; }
+
+        /// VKL_MESH_CACHE when set, vkl_mesh_cache in the working directory otherwise.
+        [[nodiscard]] static fs::path defaultDirectory();
+
+    private:
+        struct VertexAttribute {
+            uint32_t location = 0;
+            uint32_t format = 0;
+            uint32_t offset = 0;
+
+            bool operator==(const VertexAttribute &other) const noexcept = default;
+        };
+
+        struct SourceStamp {
+            uint64_t size = 0;
+            int64_t mtime = 0;
+        };
+
+        struct FileHeader {
+            std::array<char, 4> magic{'V', 'K', 'L', 'M'};
+            uint32_t version = VERSION;
+            SourceStamp source{};
+            uint64_t sourceHash = 0;
+            uint32_t vertexStride = 0;
+            uint32_t attributeCount = 0;
+            std::array<VertexAttribute, MAX_ATTRIBUTES> attributes{};
+            uint32_t vertexCount = 0;
+            uint32_t indexCount = 0;
+            uint32_t indexType = 0;
+            uint32_t reserved = 0;
+            uint64_t vertexOffset = 0;
+            uint64_t indexOffset = 0;
+            Model::Bounds bounds{};
+        };
+        static_assert(std::is_trivially_copyable_v<FileHeader>);
+
+        template <typename Vertex> [[nodiscard]] static FileHeader layoutHeaderOf();
+        [[nodiscard]] static FileHeader layoutHeader(VertexFormat format);
+        [[nodiscard]] static SourceStamp stampOf(const fs::path &source);
+        [[nodiscard]] std::unique_ptr<Model> tryLoad(Device &device, const fs::path &cachePath, const fs::path &source,
+                                                     VertexFormat format) const;
+        static void restamp(const fs::path &cachePath, const FileHeader &header);
+        void write(const fs::path &cachePath, const FileHeader &header, std::span<const std::byte> vertexData,
+                   std::span<const uint32_t> indices) const;
+
+        fs::path directory_;
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
@@ -0,0 +1,141 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "Device.hpp"
+#include "Util.hpp"
+#include "VertexLayout.hpp"
+
+namespace lve {
+
+    struct MeshData;
+
+    enum class VertexFormat : uint8_t { Float, Quantized };
+
+    /**
+     * @brief Indexed mesh living in DEVICE_LOCAL vertex and index buffers.
+     * The data is written once into a host visible staging buffer and copied with a single upload batch, which the
+     * constructor waits for. Indices are stored as 16 bit whenever every vertex can be addressed that way, halving
+     * the index fetch bandwidth of small meshes. Without indices the vertices are drawn as a plain list. Vertices are
+     * either full float Vertex or the 20 byte QuantizedVertex, see VertexFormat.
+     */
+    class Model {
+    public:
+        struct Vertex {
+            glm::vec3 position{};
+            glm::vec3 color{1.0f};
+            glm::vec3 normal{};
+            glm::vec2 uv{};
+
+            [[nodiscard]] static std::vector<VkVertexInputBindingDescription> getBindingDescriptions();
+            [[nodiscard]] static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions();
+
+            bool operator==(const Vertex &other) const noexcept = default;
+        };
+
+        /**
+         * @brief Vertex packed for bandwidth: half float position, octahedral normal, 16 bit uv in [0, 1] and 8 bit color.
+         * Position, color and uv reach the shader as the same float inputs as Vertex, the normal does not: it arrives
+         * as the encoded vec2, which a shader has to decode with fromOctahedral from shaders/octahedral.glsl.
+         */
+        struct QuantizedVertex {
+            Half4 position;  // w = 1
+            Unorm8x4 color;
+            Snorm16x2 normal;
+            Unorm16x2 uv;
+
+            [[nodiscard]] static std::vector<VkVertexInputBindingDescription> getBindingDescriptions();
+            [[nodiscard]] static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions();
+        };
+
+        /// Axis aligned box and bounding sphere (centered on the box) of the vertex positions.
+        struct Bounds {
+            glm::vec3 min{};
+            glm::vec3 max{};
+            glm::vec3 center{};
+            float radius = 0.0f;
+
+            [[nodiscard]] static Bounds of(std::span<const Vertex> vertices) noexcept;
+        };
+
+        Model(Device &device, std::span<const Vertex> vertices, std::span<const uint32_t> indices = {});
+        Model(Device &device, const MeshData &mesh);
+        Model(Device &device, std::span<const QuantizedVertex> vertices, std::span<const uint32_t> indices, const Bounds &bounds);
+        /// Uploads vertices and indices already packed as indexType, e.g. straight out of a mapped mesh cache.
+        Model(Device &device, std::span<const std::byte> vertexData, uint32_t vertexStride, std::span<const std::byte> indexData,
+              VkIndexType indexType, const Bounds &bounds);
+        ~Model();
+
+        Model(const Model &) = delete;
+        Model &operator=(const Model &) = delete;
+
+        void bind(VkCommandBuffer commandBuffer) const;
+        void draw(VkCommandBuffer commandBuffer, uint32_t instanceCount = 1) const;
+
+        [[nodiscard]] uint32_t vertexCount() const noexcept { return vertexCount_; }
+        [[nodiscard]] uint32_t indexCount() const noexcept { return indexCount_; }
+        [[nodiscard]] bool hasIndexBuffer() const noexcept { return indexCount_ > 0; }
+        [[nodiscard]] VkIndexType indexType() const noexcept { return indexType_; }
+        [[nodiscard]] const Bounds &bounds() const noexcept { return bounds_; }
+        [[nodiscard]] uint32_t vertexStride() const noexcept { return vertexStride_; }
+
+        /// Packs vertices with the quantize kernels; uvs outside [0, 1] are clamped.
+        [[nodiscard]] static std::vector<QuantizedVertex> quantizeVertices(std::span<const Vertex> vertices);
+
+        /// 0xFFFF stays free so primitive restart can be turned on without touching the data.
+        [[nodiscard]] static VkIndexType indexTypeFor(std::size_t vertexCount) noexcept {
+            return vertexCount < std::numeric_limits<uint16_t>::max() ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+        }
+        [[nodiscard]] static std::size_t indexSize(VkIndexType type) noexcept {
+            return type == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+        }
+
+    private:
+        void uploadIndexed(std::span<const std::byte> vertexData, std::span<const uint32_t> indices);
+        /// Creates the buffers and copies them through one staging buffer, writeIndices fills the index part of it.
+        template <typename WriteIndices>
+        void upload(std::span<const std::byte> vertexData, VkDeviceSize indexBytes, WriteIndices &&writeIndices);
+
+        Device &lveDevice;
+        VkBuffer vertexBuffer{};
+        Allocation vertexAllocation{};
+        VkBuffer indexBuffer{};
+        Allocation indexAllocation{};
+        uint32_t vertexStride_;
+        uint32_t vertexCount_;
+        uint32_t indexCount_;
+        VkIndexType indexType_ = VK_INDEX_TYPE_UINT32;
+        Bounds bounds_{};
+    };
+
+    /// Indexed mesh on the CPU side, as produced by the loaders and consumed by Model.
+    struct MeshData {
+        std::vector<Model::Vertex> vertices;
+        std::vector<uint32_t> indices;
+    };
+
+    template <>
+    struct VertexLayout<Model::Vertex>
+      : VertexLayoutOf<Model::Vertex, VKL_VERTEX_ATTRIBUTE(Model::Vertex, position), VKL_VERTEX_ATTRIBUTE(Model::Vertex, color),
+                       VKL_VERTEX_ATTRIBUTE(Model::Vertex, normal), VKL_VERTEX_ATTRIBUTE(Model::Vertex, uv)> {};
+
+    template <>
+    struct VertexLayout<Model::QuantizedVertex>
+      : VertexLayoutOf<Model::QuantizedVertex, VKL_VERTEX_ATTRIBUTE(Model::QuantizedVertex, position),
+                       VKL_VERTEX_ATTRIBUTE(Model::QuantizedVertex, color), VKL_VERTEX_ATTRIBUTE(Model::QuantizedVertex, normal),
+                       VKL_VERTEX_ATTRIBUTE(Model::QuantizedVertex, uv)> {};
+    static_assert(VertexLayout<Model::QuantizedVertex>::stride == 20);
+
+}  // namespace lve
+
+template <> struct std::hash<lve::Model::Vertex> {
+    std::size_t operator()(const lve::Model::Vertex &vertex) const noexcept {
+        std::size_t seed = 0;
+        lve::hashCombine(seed, vertex.position, vertex.normal, vertex.uv);
+        return seed;
+    }
+};
+
+// NOLINTEND(*-include-cleaner)
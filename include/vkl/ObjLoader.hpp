@@ -0,0 +1,31 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "Model.hpp"
+#include "ThreadPool.hpp"
+
+namespace lve {
+
+    /**
+     * @brief Wavefront OBJ loader producing an indexed MeshData.
+     * The file is memory mapped and split at line boundaries into chunks parsed on the threads of the pool; a cheap
+     * first pass counts the v/vt/vn lines of every chunk so that each chunk knows its global attribute offsets and
+     * writes them in place, relative (negative) indices included. Polygons are fan triangulated, and the corners are
+     * then deduplicated with an open addressing table keyed on position, normal and uv. Supports v (with the optional
+     * per vertex rgb extension), vt, vn and f; every other statement is ignored.
+     */
+    class ObjLoader {
+    public:
+        static constexpr std::size_t MIN_CHUNK_BYTES = std::size_t{1} << 20;
+
+        [[nodiscard]] static MeshData load(const fs::path &path, ThreadPool &pool);
+        /// Parses OBJ text already in memory, path is only used in messages.
+        [[nodiscard]] static MeshData parse(std::string_view text, ThreadPool &pool, std::string_view path = "<memory>");
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
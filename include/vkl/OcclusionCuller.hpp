@@ -0,0 +1,90 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "DepthPyramid.hpp"
+#include "GpuScene.hpp"
+
+namespace lve {
+
+    /**
+     * @brief Two-phase occlusion culling of a GpuScene against a DepthPyramid, on top of the frustum tests of GpuCuller.
+     * recordEarly() compacts the frustum-visible objects that passed the occlusion test last frame into the scene's
+     * indirect buffer; once they are drawn and the pyramid is built from their depth, recordLate() tests every
+     * frustum-visible object against it, keeps the result for the next frame and compacts the visible objects the early
+     * pass did not draw, so the scene is drawn a second time without clearing. An object hidden last frame that shows up
+     * this frame is therefore drawn in the same frame, a pass late. occlusion_cull.comp implements both phases.
+     * Draws and triangles of each phase are read back per frame in flight like GpuCuller::stats.
+     */
+    class OcclusionCuller {
+    public:
+        static constexpr uint32_t GROUP_SIZE = 64;  // local_size_x of occlusion_cull.comp
+
+        struct Stats {
+            uint32_t earlyDraws = 0;
+            uint32_t lateDraws = 0;
+            uint64_t triangles = 0;
+            uint32_t culled = 0;
+
+            bool operator==(const Stats &other) const noexcept = default;
+        };
+
+        OcclusionCuller(Device &device, const GpuScene &scene, const DepthPyramid &pyramid, std::size_t framesInFlight);
+        ~OcclusionCuller();
+
+        OcclusionCuller(const OcclusionCuller &) = delete;
+        OcclusionCuller &operator=(const OcclusionCuller &) = delete;
+
+        /// Points the late phase at a recreated pyramid; no pass using the previous one may be pending.
+        void setPyramid(const DepthPyramid &pyramid);
+
+        /// Records the early phase for frame slot frameIndex, outside of any render pass.
+        void recordEarly(VkCommandBuffer commandBuffer, std::size_t frameIndex, const glm::mat4 &viewProjection);
+        /// Records the late phase, after DepthPyramid::build of the early draws; the scene holds the late draws afterwards.
+        void recordLate(VkCommandBuffer commandBuffer, std::size_t frameIndex, const glm::mat4 &viewProjection);
+        /// Result of the last frame recorded in frameIndex, which must have retired; empty before the first one.
+        [[nodiscard]] std::optional<Stats> stats(std::size_t frameIndex) const;
+
+    private:
+        enum Phase : uint32_t { Early, Late };
+
+        struct PushConstants {
+            glm::mat4 viewProjection;
+            uint32_t objectCount;
+            uint32_t phase;
+            glm::vec2 depthSize;
+        };
+
+        // uints of a readback slot: early draws, late draws, early triangles, late triangles
+        static constexpr std::size_t READBACK_SLOT_UINTS = 4;
+
+        void createDescriptors();
+        void writePyramidDescriptor();
+        void createPipelineLayout();
+        void record(VkCommandBuffer commandBuffer, std::size_t slot, const glm::mat4 &viewProjection, Phase phase);
+
+        Device &lveDevice;
+        const GpuScene &scene;
+        const DepthPyramid *pyramid;
+        VkBuffer visibilityBuffer{};  // one uint per object, non zero when it passed the last late phase
+        Allocation visibilityAllocation{};
+        VkBuffer statsBuffer{};  // triangles submitted by each phase
+        Allocation statsAllocation{};
+        bool visibilityCleared = false;
+
+        VkDescriptorSetLayout setLayout{};
+        VkDescriptorPool descriptorPool{};
+        VkDescriptorSet descriptorSet{};
+        VkPipelineLayout pipelineLayout{};
+        std::unique_ptr<ComputePipeline> pipeline;
+
+        VkBuffer readbackBuffer{};
+        Allocation readbackAllocation{};
+        std::vector<uint32_t> slotObjects;  // objects culled by the last frame of each slot, 0 before the first
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
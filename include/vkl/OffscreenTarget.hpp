@@ -0,0 +1,85 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+#include "Device.hpp"
+
+namespace lve {
+
+    /**
+     * @brief Render target standing in for SwapChain when there is no surface to present to.
+     * Owns a ring of color images sharing one transient depth image, a render pass and framebuffers, and exposes the same frame
+     * API as SwapChain so that frame loops work unchanged on a headless Device. acquireNextImage never blocks on a
+     * display: images are handed out round robin and only wait for the GPU to be done with them. Rendered color images
+     * are left in TRANSFER_SRC_OPTIMAL so they can be read back.
+     */
+    class OffscreenTarget {
+    public:
+        static constexpr int MAX_FRAMES_IN_FLIGHT = 2;
+        static constexpr VkFormat DEFAULT_COLOR_FORMAT = VK_FORMAT_B8G8R8A8_UNORM;
+
+        OffscreenTarget(Device &deviceRef, VkExtent2D targetExtent, uint32_t count = MAX_FRAMES_IN_FLIGHT + 1,
+                        VkFormat format = DEFAULT_COLOR_FORMAT);
+        ~OffscreenTarget();
+
+        OffscreenTarget(const OffscreenTarget &) = delete;
+        OffscreenTarget &operator=(const OffscreenTarget &) = delete;
+
+        VkFramebuffer getFrameBuffer(int index) { return framebuffers[index]; }
+        VkRenderPass getRenderPass() { return renderPass; }
+        VkImageView getImageView(int index) { return colorImageViews[index]; }
+        VkImage getImage(int index) { return colorImages[index]; }
+        size_t imageCount() { return colorImages.size(); }
+        VkFormat getSwapChainImageFormat() { return colorFormat; }
+        VkExtent2D getSwapChainExtent() { return extent; }
+        uint32_t width() { return extent.width; }
+        uint32_t height() { return extent.height; }
+        size_t getCurrentFrame() const noexcept { return currentFrame; }
+
+        float extentAspectRatio() { return static_cast<float>(extent.width) / static_cast<float>(extent.height); }
+        VkFormat findDepthFormat();
+
+        VkResult acquireNextImage(uint32_t *imageIndex);
+        VkResult submitCommandBuffers(const VkCommandBuffer *buffers, uint32_t *imageIndex);
+
+        // same timeline frame pacing as SwapChain
+        [[nodiscard]] uint64_t frameNumber() const noexcept { return submittedFrames + 1; }
+        [[nodiscard]] uint64_t completedFrame() const;
+        [[nodiscard]] bool isFrameRetired(uint64_t frame) const { return frame <= completedFrame(); }
+        void waitForFrame(uint64_t frame) const;
+        [[nodiscard]] VkSemaphore frameTimeline() const noexcept { return timeline; }
+
+    private:
+        void createColorResources(uint32_t count);
+        void createDepthResources();
+        void createRenderPass();
+        void createFramebuffers();
+        void createSyncObjects();
+
+        VkFormat colorFormat;
+        VkExtent2D extent;
+
+        std::vector<VkFramebuffer> framebuffers;
+        VkRenderPass renderPass{};
+
+        std::vector<VkImage> colorImages;
+        std::vector<Allocation> colorImageAllocations;
+        std::vector<VkImageView> colorImageViews;
+        VkImage depthImage{};
+        Allocation depthImageAllocation{};
+        VkImageView depthImageView{};
+
+        Device &device;
+
+        VkSemaphore timeline{};
+        uint64_t submittedFrames = 0;
+        std::array<uint64_t, MAX_FRAMES_IN_FLIGHT> slotFrames{};
+        std::vector<uint64_t> imageFrames;  // images can be fewer than frames in flight, so they are tracked too
+        size_t currentFrame = 0;
+        uint32_t nextImage = 0;
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
@@ -5,14 +5,25 @@
 #pragma once
 
 #include "Device.hpp"
+#include "Model.hpp"
 #include "headers.hpp"
 #include "vulkanCheck.hpp"
 
 namespace lve {
 
     struct PipelineConfigInfo {
-        VkViewport viewport;
-        VkRect2D scissor;
+        PipelineConfigInfo() = default;
+        // colorBlendInfo points into the struct itself
+        PipelineConfigInfo(const PipelineConfigInfo &) = delete;
+        PipelineConfigInfo &operator=(const PipelineConfigInfo &) = delete;
+
+        // viewport and scissor are dynamic by default: the pipeline does not depend on the swapchain extent and
+        // survives resizes, the command buffer sets them with vkCmdSetViewport/vkCmdSetScissor instead
+        std::vector<VkDynamicState> dynamicStates;
+        std::vector<VkVertexInputBindingDescription> bindingDescriptions;      // Model::Vertex by default
+        std::vector<VkVertexInputAttributeDescription> attributeDescriptions;  // Model::Vertex by default
+        VkViewport viewport{};  // only used when VK_DYNAMIC_STATE_VIEWPORT is not in dynamicStates
+        VkRect2D scissor{};     // only used when VK_DYNAMIC_STATE_SCISSOR is not in dynamicStates
         VkPipelineInputAssemblyStateCreateInfo inputAssemblyInfo;
         VkPipelineRasterizationStateCreateInfo rasterizationInfo;
         VkPipelineMultisampleStateCreateInfo multisampleInfo;
@@ -22,6 +33,10 @@ namespace lve {
         VkPipelineLayout pipelineLayout = nullptr;
         VkRenderPass renderPass = nullptr;
         uint32_t subpass = 0;
+        // used instead of renderPass/subpass when renderPass is null: the pipeline is built for dynamic rendering
+        // against these attachment formats (VkPipelineRenderingCreateInfo)
+        VkFormat colorFormat = VK_FORMAT_UNDEFINED;
+        VkFormat depthFormat = VK_FORMAT_UNDEFINED;
     };
 
     class Pipeline {
@@ -32,12 +47,14 @@ namespace lve {
         Pipeline(const Pipeline &) = delete;
         Pipeline& operator=(const Pipeline &) = delete;
 
-        static PipelineConfigInfo defaultPipelineConfigInfo(uint32_t width, uint32_t height);
+        static void defaultPipelineConfigInfo(PipelineConfigInfo &configInfo);
 
         void bind(VkCommandBuffer commandBuffer);
-    private:
+
+        /// Reads a whole SPIR-V binary, shared with ComputePipeline.
         static std::vector<char> readFile(const std::string &filepath);
 
+    private:
         void createGraphicsPipeline(const std::string &vertFilepath, const std::string &fragFilepath, const PipelineConfigInfo &configInfo);
 
         void createShaderModule(const std::vector<char> &code, VkShaderModule *shaderModule);
@@ -0,0 +1,60 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "vulkanCheck.hpp"
+
+namespace lve {
+
+    /**
+     * @brief VkPipelineCache persisted on disk between runs.
+     * The blob is stored behind a small header carrying the vendorID, deviceID, driverVersion and pipelineCacheUUID of
+     * the device that produced it, plus its size and checksum; a blob from another device or driver, or a corrupt
+     * one, is discarded and the cache starts cold. Every pipeline created with handle() feeds the same cache, caches
+     * filled elsewhere can be folded in with merge(), and the result is written back atomically on destruction.
+     */
+    class PipelineCache {
+    public:
+        PipelineCache(VkDevice device, const VkPhysicalDeviceProperties &properties, fs::path path);
+        ~PipelineCache();
+
+        PipelineCache(const PipelineCache &) = delete;
+        PipelineCache &operator=(const PipelineCache &) = delete;
+        PipelineCache(PipelineCache &&) = delete;
+        PipelineCache &operator=(PipelineCache &&) = delete;
+
+        [[nodiscard]] VkPipelineCache handle() const noexcept { return cache; }
+        /// True when a valid blob was loaded from disk, i.e. pipelines are expected to hit the cache.
+        [[nodiscard]] bool isWarm() const noexcept { return warm; }
+        [[nodiscard]] const fs::path &path() const noexcept { return path_; }
+
+        void merge(std::span<const VkPipelineCache> sources);
+        void save() const;
+
+    private:
+        struct FileHeader {
+            std::array<char, 4> magic{'V', 'K', 'L', 'C'};
+            uint32_t version = 1;
+            uint32_t vendorID = 0;
+            uint32_t deviceID = 0;
+            uint32_t driverVersion = 0;
+            std::array<uint8_t, VK_UUID_SIZE> pipelineCacheUUID{};
+            uint64_t dataSize = 0;
+            uint64_t checksum = 0;
+        };
+
+        [[nodiscard]] FileHeader expectedHeader() const noexcept;
+        [[nodiscard]] std::vector<char> load() const;
+
+        VkDevice device_;
+        VkPhysicalDeviceProperties properties_;
+        fs::path path_;
+        VkPipelineCache cache{};
+        bool warm = false;
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
@@ -0,0 +1,35 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "vulkanCheck.hpp"
+
+namespace lve {
+
+    enum class PresentMode : uint8_t { Immediate, Mailbox, Fifo, FifoRelaxed };
+
+    [[nodiscard]] std::string_view toString(PresentMode mode) noexcept;
+    [[nodiscard]] std::optional<PresentMode> parsePresentMode(std::string_view name) noexcept;
+    [[nodiscard]] VkPresentModeKHR toVkPresentMode(PresentMode mode) noexcept;
+
+    /**
+     * @brief Latency versus throughput settings of a SwapChain.
+     * The requested present mode falls back to the closest supported one (FIFO is always available), imageCount is
+     * clamped to the surface limits with 0 meaning minImageCount + 1, and framesInFlight is clamped to
+     * [1, SwapChain::MAX_FRAMES_IN_FLIGHT]. Changing the policy takes effect on the next swapchain recreate.
+     */
+    struct PresentPolicy {
+        PresentMode mode = PresentMode::Mailbox;
+        uint32_t imageCount = 0;
+        uint32_t framesInFlight = 2;
+
+        /// Defaults overridden by VKL_PRESENT_MODE (immediate, mailbox, fifo, fifo_relaxed), VKL_SWAPCHAIN_IMAGES and
+        /// VKL_FRAMES_IN_FLIGHT.
+        [[nodiscard]] static PresentPolicy fromEnvironment();
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
@@ -0,0 +1,93 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "ThreadPool.hpp"
+
+namespace lve {
+
+    /**
+     * @brief CPU occlusion culling against a low resolution depth buffer, for when reading back the GPU depth is too late.
+     * render() draws a few large occluder meshes with the Vulkan clip conventions (depth z / w in [0, 1], y down): triangles
+     * are clipped to the near plane, set up once, binned to TILE_WIDTH x TILE_HEIGHT tiles and every tile is rasterized by
+     * a single thread with edge functions evaluated eight pixels at a time (AVX2 when the library is built for it). Each
+     * pixel keeps the nearest occluder depth, pushed back to the farthest value the triangle takes over the pixel, so a
+     * sample never hides more than the occluder does. isVisible() then tests world space boxes. The result does not depend
+     * on the thread count or on scheduling, the same occluders always give the same depth buffer bit for bit.
+     */
+    class SoftwareOcclusion {
+    public:
+        static constexpr uint32_t TILE_WIDTH = 32;
+        static constexpr uint32_t TILE_HEIGHT = 16;
+        static constexpr std::size_t VERTICES_PER_TASK = 4096;
+        static constexpr std::size_t TRIANGLES_PER_TASK = 1024;
+
+        /// Triangle mesh drawn into the depth buffer; the spans must stay valid for the duration of render().
+        struct Occluder {
+            std::span<const glm::vec3> positions;
+            std::span<const uint32_t> indices;
+            glm::mat4 transform{1.0f};
+        };
+
+        /// width and height must be multiples of TILE_WIDTH and TILE_HEIGHT.
+        explicit SoftwareOcclusion(uint32_t width = 256, uint32_t height = 128);
+
+        /// Clears the depth buffer and draws occluders seen through viewProjection, which isVisible() then uses too.
+        void render(std::span<const Occluder> occluders, const glm::mat4 &viewProjection, ThreadPool &pool);
+
+        /**
+         * @brief Whether any part of the world space box [min, max] may be seen past the occluders. Boxes crossing the near
+         * plane are visible, boxes outside the view are not. Safe to call from several threads after render().
+         */
+        [[nodiscard]] bool isVisible(const glm::vec3 &min, const glm::vec3 &max) const noexcept;
+
+        [[nodiscard]] uint32_t width() const noexcept { return width_; }
+        [[nodiscard]] uint32_t height() const noexcept { return height_; }
+        /// Row major, 1.0 where no occluder was drawn.
+        [[nodiscard]] std::span<const float> depth() const noexcept { return depth_; }
+        /// Triangles left after clipping and binned by the last render().
+        [[nodiscard]] std::size_t triangleCount() const noexcept { return triangles.size(); }
+
+    private:
+        struct Triangle {
+            std::array<glm::vec3, 3> edges;  // a, b, c of a * x + b * y + c, >= 0 inside
+            glm::vec3 depthPlane;            // depth at the pixel center, biased to the far side of the pixel
+            float maxDepth;
+            std::array<uint32_t, 4> bounds;  // first and last covered pixel: x0, y0, x1, y1
+        };
+
+        struct Range {
+            std::size_t occluder;
+            std::size_t first;
+            std::size_t count;
+        };
+
+        void setupTriangles(const Occluder &occluder, std::span<const glm::vec4> clip, std::size_t firstTriangle, std::size_t triangleCount,
+                            std::vector<Triangle> &out) const;
+        void clipTriangle(const std::array<glm::vec4, 3> &clip, std::vector<Triangle> &out) const;
+        void addScreenTriangle(glm::vec3 first, glm::vec3 second, glm::vec3 third, std::vector<Triangle> &out) const;
+        void rasterizeTile(std::size_t tile) noexcept;
+
+        uint32_t width_;
+        uint32_t height_;
+        uint32_t tilesX;
+        uint32_t tilesY;
+        glm::mat4 viewProjection_{1.0f};
+        std::vector<float> depth_;
+        std::vector<float> tileMaxDepth;  // farthest depth of every tile, lets isVisible skip them whole
+        std::vector<Range> vertexRanges;
+        std::vector<std::size_t> vertexTasks;  // first range of every task, then the range count
+        std::vector<Range> triangleRanges;
+        std::vector<std::size_t> triangleTasks;
+        std::vector<std::size_t> firstVertex;              // of every occluder in clipVertices
+        std::vector<glm::vec4> clipVertices;               // every occluder vertex transformed once
+        std::vector<std::vector<Triangle>> taskTriangles;  // setup output per task, concatenated in task order
+        std::vector<Triangle> triangles;
+        std::vector<std::vector<uint32_t>> bins;  // indices in triangles per tile, ascending
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
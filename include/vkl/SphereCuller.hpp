@@ -0,0 +1,46 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "BoundingSpheres.hpp"
+#include "Frustum.hpp"
+#include "ThreadPool.hpp"
+
+namespace lve {
+
+    /**
+     * @brief CPU frustum culling of BoundingSpheres, for draws recorded on the CPU and for picking.
+     * testBlocks() is the kernel: with AVX2 it tests the eight spheres of a block against the six planes at once,
+     * otherwise it runs the same test one sphere at a time (Frustum::intersectsSphere). cull() splits the blocks in tasks
+     * of BLOCKS_PER_TASK over a ThreadPool, then compacts the visible indices in a second parallel pass from the per task
+     * counts, so the result is in ascending order whatever the thread count. The buffers are kept between calls.
+     */
+    class SphereCuller {
+    public:
+        static constexpr std::size_t BLOCKS_PER_TASK = 1024;
+
+        /// Whether testBlocks runs the AVX2 kernel in this build.
+        [[nodiscard]] static bool simd() noexcept;
+
+        /**
+         * @brief Writes one visibility byte per block of bounds in [firstBlock, firstBlock + blockCount) to masks, bit i
+         * set when sphere firstBlock * 8 + i intersects frustum. Padding spheres are never visible. Returns the number of
+         * visible spheres.
+         */
+        static std::size_t testBlocks(const BoundingSpheres &bounds, const Frustum &frustum, std::size_t firstBlock, std::size_t blockCount,
+                                      uint8_t *masks) noexcept;
+
+        /// Indices of the spheres of bounds intersecting frustum, ascending; valid until the next call.
+        [[nodiscard]] std::span<const uint32_t> cull(const BoundingSpheres &bounds, const Frustum &frustum, ThreadPool &pool);
+
+    private:
+        std::vector<uint8_t> masks;           // one per block
+        std::vector<std::size_t> taskOffsets;  // visible spheres per task, then their exclusive prefix sum
+        std::vector<uint32_t> visible;
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
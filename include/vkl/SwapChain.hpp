@@ -4,27 +4,57 @@
 // NOLINTBEGIN(*-include-cleaner)
 #pragma once
 #include "Device.hpp"
+#include "PresentPolicy.hpp"
+
+#include <deque>
 
 namespace lve {
 
+    /**
+     * @brief How frames are rendered into the swapchain images.
+     * RenderPass builds a VkRenderPass and one VkFramebuffer per image, and pipelines are tied to that render pass.
+     * Dynamic skips both: command buffers begin rendering straight on the image views (vkCmdBeginRendering) and
+     * pipelines only depend on the attachment formats, so a recreate never rebuilds them unless a format changes.
+     */
+    enum class RenderingMode : uint8_t { RenderPass, Dynamic };
+
     class SwapChain {
     public:
-        static constexpr int MAX_FRAMES_IN_FLIGHT = 2;
-
-        SwapChain(Device &deviceRef, VkExtent2D windowExtent);
+        /// Upper bound of PresentPolicy::framesInFlight, per-frame resources are sized for it.
+        static constexpr int MAX_FRAMES_IN_FLIGHT = 3;
+
+        /**
+         * @brief Creates the swapchain, or recreates it in place when previous is given (resize, out of date, policy change).
+         * previous is handed to the driver as oldSwapchain; its render pass (when the surface format is unchanged) and
+         * its frame synchronization objects are taken over, and it is kept alive until every frame that could still be
+         * using its images has been waited on, so no device wide idle is needed. sampledDepth makes the depth image a
+         * regular, sampleable image instead of a transient attachment, for passes reading it such as DepthPyramid.
+         */
+        SwapChain(Device &deviceRef, VkExtent2D windowExtent, const PresentPolicy &presentPolicy = {},
+                  RenderingMode mode = RenderingMode::RenderPass, std::unique_ptr<SwapChain> previous = nullptr, bool sampledDepth = false);
         ~SwapChain();
 
         SwapChain(const SwapChain &) = delete;
         SwapChain &operator=(const SwapChain &) = delete;
 
+        // render pass and framebuffers are VK_NULL_HANDLE / empty in RenderingMode::Dynamic
         VkFramebuffer getFrameBuffer(int index) { return swapChainFramebuffers[index]; }
         VkRenderPass getRenderPass() { return renderPass; }
         VkImageView getImageView(int index) { return swapChainImageViews[index]; }
+        VkImage getImage(int index) { return swapChainImages[index]; }
+        VkImage getDepthImage() { return depthImage; }
+        VkImageView getDepthImageView() { return depthImageView; }
+        VkFormat getDepthFormat() const noexcept { return depthFormat; }
+        RenderingMode renderingMode() const noexcept { return renderingMode_; }
         size_t imageCount() { return swapChainImages.size(); }
         VkFormat getSwapChainImageFormat() { return swapChainImageFormat; }
         VkExtent2D getSwapChainExtent() { return swapChainExtent; }
         uint32_t width() { return swapChainExtent.width; }
         uint32_t height() { return swapChainExtent.height; }
+        size_t getCurrentFrame() const noexcept { return currentFrame; }
+        uint32_t framesInFlight() const noexcept { return framesInFlight_; }
+        const PresentPolicy &policy() const noexcept { return policy_; }
+        VkPresentModeKHR presentMode() const noexcept { return presentMode_; }
 
         float extentAspectRatio() { return static_cast<float>(swapChainExtent.width) / static_cast<float>(swapChainExtent.height); }
         VkFormat findDepthFormat();
@@ -32,17 +62,36 @@ namespace lve {
         VkResult acquireNextImage(uint32_t *imageIndex);
         VkResult submitCommandBuffers(const VkCommandBuffer *buffers, uint32_t *imageIndex);
 
+        /**
+         * Frame pacing runs on a single timeline semaphore: frame N signals value N when its GPU work is done, so any
+         * subsystem can test or wait for a frame without owning a fence. The counter carries over swapchain recreates.
+         */
+        [[nodiscard]] uint64_t frameNumber() const noexcept { return submittedFrames + 1; }  // frame being recorded
+        [[nodiscard]] uint64_t completedFrame() const;
+        [[nodiscard]] bool isFrameRetired(uint64_t frame) const { return frame <= completedFrame(); }
+        void waitForFrame(uint64_t frame) const;
+        [[nodiscard]] VkSemaphore frameTimeline() const noexcept { return timeline; }
+
     private:
-        void createSwapChain();
+        struct Retired {
+            std::unique_ptr<SwapChain> swapChain;
+            uint64_t lastFrame;  // last frame submitted against it
+        };
+
+        void createSwapChain(VkSwapchainKHR oldSwapChain);
         void createImageViews();
         void createDepthResources();
         void createRenderPass();
         void createFramebuffers();
         void createSyncObjects();
+        void createRenderFinishedSemaphores();
+        void adopt(std::unique_ptr<SwapChain> previous);
+        void destroyRetired();
 
         // Helper functions
         VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR> &availableFormats);
-        VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR> &availablePresentModes);
+        VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR> &availablePresentModes) const;
+        uint32_t chooseImageCount(const VkSurfaceCapabilitiesKHR &capabilities) const;
         VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR &capabilities);
 
         VkFormat swapChainImageFormat{};
@@ -51,9 +100,13 @@ namespace lve {
         std::vector<VkFramebuffer> swapChainFramebuffers;
         VkRenderPass renderPass{};
 
-        std::vector<VkImage> depthImages;
-        std::vector<VkDeviceMemory> depthImageMemorys;
-        std::vector<VkImageView> depthImageViews;
+        // one depth image shared by every framebuffer: it is cleared on load and, unless sampled, never stored; the render pass
+        // dependency (or the barrier recorded before vkCmdBeginRendering) orders each frame's depth writes after the
+        // previous frame's
+        VkFormat depthFormat{};
+        VkImage depthImage{};
+        Allocation depthImageAllocation{};
+        VkImageView depthImageView{};
         std::vector<VkImage> swapChainImages;
         std::vector<VkImageView> swapChainImageViews;
 
@@ -61,12 +114,19 @@ namespace lve {
         VkExtent2D windowExtent;
 
         VkSwapchainKHR swapChain{};
-
-        std::vector<VkSemaphore> imageAvailableSemaphores;
-        std::vector<VkSemaphore> renderFinishedSemaphores;
-        std::vector<VkFence> inFlightFences;
-        std::vector<VkFence> imagesInFlight;
+        PresentPolicy policy_;
+        RenderingMode renderingMode_;
+        bool sampledDepth_;
+        uint32_t framesInFlight_;
+        VkPresentModeKHR presentMode_{};
+
+        std::vector<VkSemaphore> imageAvailableSemaphores;  // per frame slot
+        std::vector<VkSemaphore> renderFinishedSemaphores;  // per swapchain image, reused only once the image is reacquired
+        VkSemaphore timeline{};
+        uint64_t submittedFrames = 0;
+        std::array<uint64_t, MAX_FRAMES_IN_FLIGHT> slotFrames{};  // last frame recorded in each slot
         size_t currentFrame = 0;
+        std::deque<Retired> retired;
     };
 
 }  // namespace lve
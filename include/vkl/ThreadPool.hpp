@@ -0,0 +1,57 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "headers.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace lve {
+
+    /**
+     * @brief Fixed set of worker threads running fork-join loops.
+     * parallelFor() hands out task indices from a shared counter to the workers and to the calling thread, which takes
+     * part as thread 0, and returns once every task ran. Thread indices are stable in [0, threadCount()), so they can
+     * select per-thread resources such as the command pools of a FrameContext. Workers sleep between loops.
+     */
+    class ThreadPool {
+    public:
+        using Task = std::function<void(std::size_t index, uint32_t thread)>;
+
+        /// threadCount includes the calling thread, 1 runs everything inline.
+        explicit ThreadPool(uint32_t threadCount = defaultThreadCount());
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        [[nodiscard]] static uint32_t defaultThreadCount() noexcept;
+        [[nodiscard]] uint32_t threadCount() const noexcept { return C_UI32T(workers.size()) + 1; }
+
+        /// Runs task(index, thread) for every index in [0, taskCount); the first exception thrown by a task is rethrown.
+        void parallelFor(std::size_t taskCount, const Task &task);
+
+    private:
+        void workerLoop(const std::stop_token &stopToken, uint32_t thread);
+        void runTasks(uint32_t thread) noexcept;
+
+        std::mutex mutex;
+        std::condition_variable_any wake;
+        std::condition_variable done;
+        const Task *job = nullptr;
+        std::size_t jobSize = 0;
+        std::atomic<std::size_t> nextTask{0};
+        uint64_t generation = 0;
+        uint32_t activeWorkers = 0;
+        std::exception_ptr error;
+        std::vector<std::jthread> workers;  // last member: joined before the state above is destroyed
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
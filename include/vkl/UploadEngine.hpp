@@ -0,0 +1,134 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#pragma once
+
+#include "Device.hpp"
+
+#include <deque>
+#include <mutex>
+
+namespace lve {
+
+    /// Timeline value that is reached once an upload is visible to the graphics queue.
+    using UploadTicket = uint64_t;
+
+    /**
+     * @brief Set of staging copies recorded together and submitted with a single flush.
+     * Regions sharing the same source and destination are merged into one copy command, and contiguous regions are
+     * coalesced. Image copies carry their layout transitions, which are batched into one barrier before and one after
+     * all the copies; the layouts given by the first copy into an image apply to all of its regions.
+     */
+    class UploadBatch {
+    public:
+        void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size, VkDeviceSize srcOffset = 0, VkDeviceSize dstOffset = 0);
+        void copyBufferToImage(VkBuffer buffer, VkImage image, const VkBufferImageCopy &region,
+                               VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                               VkImageLayout initialLayout = VK_IMAGE_LAYOUT_UNDEFINED);
+        void copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height, uint32_t layerCount,
+                               VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                               VkImageLayout initialLayout = VK_IMAGE_LAYOUT_UNDEFINED);
+
+        [[nodiscard]] bool empty() const noexcept { return bufferCopies.empty() && imageCopies.empty(); }
+        [[nodiscard]] std::size_t regionCount() const noexcept { return regionCount_; }
+        [[nodiscard]] VkDeviceSize byteCount() const noexcept { return byteCount_; }  // buffer to buffer bytes only
+
+    private:
+        friend class UploadEngine;
+
+        struct BufferCopies {
+            VkBuffer src;
+            VkBuffer dst;
+            std::vector<VkBufferCopy> regions;
+        };
+
+        struct ImageCopies {
+            VkBuffer src;
+            VkImage image;
+            VkImageLayout initialLayout;
+            VkImageLayout finalLayout;
+            VkImageSubresourceRange range;
+            std::vector<VkBufferImageCopy> regions;
+        };
+
+        void coalesce();
+
+        std::vector<BufferCopies> bufferCopies;
+        std::vector<ImageCopies> imageCopies;
+        std::map<std::pair<VkBuffer, VkBuffer>, std::size_t> bufferLookup;
+        std::map<VkImage, std::size_t> imageLookup;
+        std::size_t regionCount_ = 0;
+        VkDeviceSize byteCount_ = 0;
+    };
+
+    /**
+     * @brief Asynchronous copy engine running on the dedicated transfer queue when the device exposes one.
+     * Copies are recorded into pooled command buffers and signal a timeline semaphore; the returned ticket can be
+     * polled or waited on only when the data is actually needed. When the transfer family differs from the graphics
+     * family the queue family ownership release/acquire pair is recorded and submitted automatically, the acquire
+     * half running on the graphics queue, so the resources are ready for graphics use once the ticket is reached.
+     * Submissions touch the graphics queue, so the engine must be driven from the thread that owns that queue.
+     */
+    class UploadEngine {
+    public:
+        explicit UploadEngine(Device &device);
+        ~UploadEngine();
+
+        UploadEngine(const UploadEngine &) = delete;
+        UploadEngine &operator=(const UploadEngine &) = delete;
+        UploadEngine(UploadEngine &&) = delete;
+        UploadEngine &operator=(UploadEngine &&) = delete;
+
+        [[nodiscard]] UploadBatch beginBatch() const { return {}; }
+        [[nodiscard]] UploadTicket flush(UploadBatch &&batch);
+
+        [[nodiscard]] UploadTicket copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size, VkDeviceSize srcOffset = 0,
+                                              VkDeviceSize dstOffset = 0);
+        [[nodiscard]] UploadTicket copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height, uint32_t layerCount);
+
+        [[nodiscard]] bool isComplete(UploadTicket ticket) const;
+        void wait(UploadTicket ticket) const;
+        void waitIdle() const { wait(lastTicket); }
+
+        [[nodiscard]] UploadTicket lastSubmitted() const noexcept { return lastTicket; }
+        [[nodiscard]] bool hasDedicatedTransferQueue() const noexcept { return dedicated; }
+        [[nodiscard]] VkSemaphore timelineSemaphore() const noexcept { return timeline; }
+
+    private:
+        struct Submission {
+            VkCommandBuffer transfer = VK_NULL_HANDLE;
+            VkCommandBuffer acquire = VK_NULL_HANDLE;
+            UploadTicket ticket = 0;
+        };
+
+        void recordCopies(VkCommandBuffer commandBuffer, const UploadBatch &batch) const;
+        void recordPostBarriers(VkCommandBuffer commandBuffer, const UploadBatch &batch, uint32_t srcFamily, uint32_t dstFamily,
+                                bool release) const;
+
+        void recycle();
+        [[nodiscard]] VkCommandBuffer obtain(VkCommandPool pool, std::vector<VkCommandBuffer> &freeList);
+        [[nodiscard]] uint64_t counterValue() const;
+        void submitTo(VkQueue queue, VkCommandBuffer commandBuffer, VkSemaphore waitSemaphore, uint64_t waitValue,
+                      VkPipelineStageFlags waitStage, VkSemaphore signalSemaphore, uint64_t signalValue);
+
+        Device &lveDevice;
+        bool dedicated;
+        uint32_t transferFamily;
+        uint32_t graphicsFamily;
+        VkCommandPool transferPool{};
+        VkCommandPool acquirePool{};
+        VkSemaphore timeline{};         // tickets, signaled only from the graphics queue
+        VkSemaphore releaseTimeline{};  // release halves, signaled only from the transfer queue
+        uint64_t nextValue = 1;
+        uint64_t nextRelease = 1;
+        UploadTicket lastTicket = 0;
+        std::deque<Submission> inFlight;
+        std::vector<VkCommandBuffer> freeTransfer;
+        std::vector<VkCommandBuffer> freeAcquire;
+        mutable std::mutex mutex;
+    };
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
+#include <span>
 
 namespace lve {
     static inline constexpr auto golden_ratio = 0x9e3779b9;
@@ -14,4 +16,13 @@ namespace lve {
         (hashCombine(seed, rest), ...);
     };
 
+    /// 64 bit FNV-1a, used to checksum and key files written to disk.
+    inline uint64_t fnv1a(std::span<const char> data, uint64_t hash = 0xcbf29ce484222325ULL) noexcept {
+        for(const char byte : data) {
+            hash ^= static_cast<uint8_t>(byte);
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
 }  // namespace lve
@@ -0,0 +1,70 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner, *-macro-usage)
+#pragma once
+
+#include "vulkanCheck.hpp"
+
+namespace lve {
+
+    /// Packed vertex attribute types, each expanded to floats by the vertex input stage.
+    struct Half4 {
+        std::array<uint16_t, 4> value{};
+    };
+    struct Snorm16x2 {
+        std::array<int16_t, 2> value{};
+    };
+    struct Unorm16x2 {
+        std::array<uint16_t, 2> value{};
+    };
+    struct Unorm8x4 {
+        std::array<uint8_t, 4> value{};
+    };
+
+    /// VkFormat a vertex attribute of type T is read with.
+    template <typename T> inline constexpr VkFormat vertexFormatOf = VK_FORMAT_UNDEFINED;
+    template <> inline constexpr VkFormat vertexFormatOf<float> = VK_FORMAT_R32_SFLOAT;
+    template <> inline constexpr VkFormat vertexFormatOf<glm::vec2> = VK_FORMAT_R32G32_SFLOAT;
+    template <> inline constexpr VkFormat vertexFormatOf<glm::vec3> = VK_FORMAT_R32G32B32_SFLOAT;
+    template <> inline constexpr VkFormat vertexFormatOf<glm::vec4> = VK_FORMAT_R32G32B32A32_SFLOAT;
+    // three component 16 bit formats are rarely supported as vertex input, hence Half4
+    template <> inline constexpr VkFormat vertexFormatOf<Half4> = VK_FORMAT_R16G16B16A16_SFLOAT;
+    template <> inline constexpr VkFormat vertexFormatOf<Snorm16x2> = VK_FORMAT_R16G16_SNORM;
+    template <> inline constexpr VkFormat vertexFormatOf<Unorm16x2> = VK_FORMAT_R16G16_UNORM;
+    template <> inline constexpr VkFormat vertexFormatOf<Unorm8x4> = VK_FORMAT_R8G8B8A8_UNORM;
+
+    template <typename Member, uint32_t Offset> struct VertexAttribute {
+        static_assert(vertexFormatOf<Member> != VK_FORMAT_UNDEFINED, "no vertex input format for this attribute type");
+        static constexpr VkFormat format = vertexFormatOf<Member>;
+        static constexpr uint32_t offset = Offset;
+    };
+
+    /**
+     * @brief Binding and attribute descriptions of Vertex, built at compile time from its attribute list.
+     * Attributes get consecutive shader locations in the order they are listed, all from binding 0. Declare the
+     * attributes with VKL_VERTEX_ATTRIBUTE in a VertexLayout specialization next to the vertex type.
+     */
+    template <typename Vertex, typename... Attributes> struct VertexLayoutOf {
+        static constexpr uint32_t stride = sizeof(Vertex);
+
+        static constexpr std::array<VkVertexInputBindingDescription, 1> bindings{
+            {{.binding = 0, .stride = stride, .inputRate = VK_VERTEX_INPUT_RATE_VERTEX}}};
+
+        static constexpr std::array<VkVertexInputAttributeDescription, sizeof...(Attributes)> attributes = [] {
+            std::array<VkVertexInputAttributeDescription, sizeof...(Attributes)> result{};
+            uint32_t location = 0;
+            ((result[location] = {.location = location, .binding = 0, .format = Attributes::format, .offset = Attributes::offset},
+              location++),
+             ...);
+            return result;
+        }();
+    };
+
+    template <typename Vertex> struct VertexLayout;
+
+}  // namespace lve
+
+#define VKL_VERTEX_ATTRIBUTE(Vertex, member) lve::VertexAttribute<decltype(Vertex::member), offsetof(Vertex, member)>
+
+// NOLINTEND(*-include-cleaner, *-macro-usage)
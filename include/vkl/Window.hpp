@@ -26,7 +26,6 @@ namespace lve {
 
         static void errorCallback(int error, const char *description);
         static void keyCallback(GLFWwindow *window, int key, int scancode, int action, int mods);
-        //static void framebufferResizeCallback(GLFWwindow *window, int width, int height) noexcept;
     class Window {  // NOLINT(*-special-member-functions)
     public:
         Window(const int w, const int h, const std::string_view &window_name) noexcept;
@@ -44,9 +43,14 @@ namespace lve {
         [[nodiscard]] VkExtent2D getExtent() const noexcept { return {C_UI32T(width), C_UI32T(height)}; }
         [[nodiscard]] bool wasWindowResized() noexcept { return framebufferResized; }
         void resetWindowResizedFlag() noexcept { framebufferResized = false; }
+        void onKeyPress(int key) noexcept { lastKeyPress = key; }
+        /// Last key pressed since the previous call, GLFW_KEY_UNKNOWN when none.
+        [[nodiscard]] int takeKeyPress() noexcept { return std::exchange(lastKeyPress, GLFW_KEY_UNKNOWN); }
 
         static void initializeGLFW();
     private:
+        static void framebufferResizeCallback(GLFWwindow *glfwWindow, int newWidth, int newHeight) noexcept;
+
         void initWindow();
 
         void createWindow();
@@ -60,6 +64,7 @@ namespace lve {
         int width;
         int height;
         bool framebufferResized = false;
+        int lastKeyPress = GLFW_KEY_UNKNOWN;
         std::string_view windowName;
         GLFWwindow* window{nullptr};
     };
@@ -1,5 +1,9 @@
 #pragma once
 // NOLINTBEGIN(*-include-cleaner)
+#include "FrameContext.hpp"
+#include "FrameRingBuffer.hpp"
+#include "GpuCuller.hpp"
+#include "OcclusionCuller.hpp"
 #include "Pipeline.hpp"
 #include "SwapChain.hpp"
 #include "Window.hpp"
@@ -47,6 +51,8 @@ namespace lve {
 
     class App {
     public:
+        static constexpr VkDeviceSize FRAME_RING_SIZE = VkDeviceSize{4} * 1024 * 1024;
+
         App();
         ~App();
 
@@ -56,17 +62,52 @@ namespace lve {
         void run();
 
     private:
+        /// Dynamic rendering when the device supports it, unless VKL_DYNAMIC_RENDERING=0 forces render pass objects.
+        [[nodiscard]] static RenderingMode chooseRenderingMode(const Device &device);
+        /// Number of draws recorded per frame, VKL_DRAW_COUNT or 1.
+        [[nodiscard]] static std::size_t drawCountFromEnvironment();
+        /// Quantized vertices when VKL_QUANTIZE=1, full floats otherwise.
+        [[nodiscard]] static VertexFormat vertexFormatFromEnvironment();
+        /// GPU driven indirect drawing of the draw count objects when VKL_GPU_DRIVEN=1.
+        [[nodiscard]] static bool gpuDrivenFromEnvironment();
+        /// Two-phase occlusion culling of the GPU driven scene when VKL_OCCLUSION=1; it needs dynamic rendering.
+        [[nodiscard]] static bool occlusionFromEnvironment(bool gpuDriven, RenderingMode mode);
+        void loadModels();
+        /// Lays drawCount instances of mesh out on a grid covering the viewport.
+        void buildScene(const MeshData &mesh);
         void createPipelineLayout();
         void createPipeline();
-        void createCommandBuffers();
+        void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+        void executeDraws(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+        void recordDraws(VkCommandBuffer commandBuffer, std::size_t firstDraw, std::size_t drawCount);
+        /// resume continues the pass ended for the depth pyramid: the attachments are loaded instead of cleared.
+        void beginRendering(VkCommandBuffer commandBuffer, uint32_t imageIndex, bool resume = false);
+        void endRendering(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+        void recreateSwapChain();
+        void handlePresentPolicyKeys();
         void drawFrame();
 
         Window lveWindow{WWIDTH, WHEIGHT, WTITILE};
         Device lveDevice{lveWindow};
-        SwapChain lveSwapChain{lveDevice, lveWindow.getExtent()};
+        PresentPolicy presentPolicy = PresentPolicy::fromEnvironment();
+        RenderingMode renderingMode = chooseRenderingMode(lveDevice);
+        std::unique_ptr<SwapChain> lveSwapChain;
+        FrameRingBuffer frameRing{lveDevice, FRAME_RING_SIZE, SwapChain::MAX_FRAMES_IN_FLIGHT};
+        ThreadPool recordPool{};
+        FrameContext frameContext{lveDevice, SwapChain::MAX_FRAMES_IN_FLIGHT, recordPool.threadCount()};
+        std::size_t drawCount = drawCountFromEnvironment();
+        VertexFormat vertexFormat = vertexFormatFromEnvironment();
+        bool gpuDriven = gpuDrivenFromEnvironment();
+        bool occlusion = occlusionFromEnvironment(gpuDriven, renderingMode);
+        std::unique_ptr<Model> lveModel;
+        std::unique_ptr<GpuScene> gpuScene;
+        std::unique_ptr<GpuCuller> gpuCuller;
+        std::optional<GpuCuller::Stats> cullStats;
+        std::unique_ptr<DepthPyramid> depthPyramid;
+        std::unique_ptr<OcclusionCuller> occlusionCuller;
+        std::optional<OcclusionCuller::Stats> occlusionStats;
         std::unique_ptr<Pipeline> lvePipeline;
         VkPipelineLayout pipelineLayout{};
-        std::vector<VkCommandBuffer> commandBuffers;
     };
 }  // namespace lve
 
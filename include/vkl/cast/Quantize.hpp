@@ -0,0 +1,201 @@
+//
+// Created by gbian on 17/10/2026.
+//
+
+// NOLINTBEGIN(*-magic-numbers, *-avoid-magic-numbers, *-reinterpret-cast, *-pointer-arithmetic)
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <span>
+
+#if defined(__AVX2__) && (defined(__F16C__) || defined(_MSC_VER))
+#include <immintrin.h>
+#define VKL_QUANTIZE_AVX2 1
+#endif
+
+/**
+ * @brief Conversions of float vertex data to the packed formats vertex input can expand for free.
+ * The scalar functions convert one value and round to nearest even, like the hardware. The span overloads convert
+ * whole arrays, eight lanes at a time with F16C/AVX2 when the target has them and with the scalar functions
+ * otherwise; both paths give identical results, NaN payloads aside. Out of range values are clamped and NaN maps to
+ * the lowest value of normalized formats.
+ *
+ * @namespace quantize
+ * @{
+ */
+namespace quantize {
+    /// IEEE 754 binary16 bits of value, overflow goes to infinity and NaN stays NaN.
+    [[nodiscard]] constexpr uint16_t toHalf(float value) noexcept {
+        const uint32_t bits = std::bit_cast<uint32_t>(value);
+        const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000U);
+        uint32_t magnitude = bits & 0x7FFFFFFFU;
+        if(magnitude >= 0x47800000U) { return sign | (magnitude > 0x7F800000U ? 0x7E00U : 0x7C00U); }
+        if(magnitude < 0x38800000U) {
+            // half subnormal: the float adder aligns and rounds the mantissa for us
+            const float aligned = std::bit_cast<float>(magnitude) + 0.5f;
+            return sign | static_cast<uint16_t>(std::bit_cast<uint32_t>(aligned) - 0x3F000000U);
+        }
+        const uint32_t mantissaOdd = (magnitude >> 13) & 1U;
+        magnitude += 0xC8000FFFU + mantissaOdd;  // rebias the exponent and round to nearest even
+        return sign | static_cast<uint16_t>(magnitude >> 13);
+    }
+
+    [[nodiscard]] constexpr float fromHalf(uint16_t half) noexcept {
+        constexpr uint32_t exponentMask = 0x7C00U << 13;
+        uint32_t bits = (half & 0x7FFFU) << 13;
+        const uint32_t exponent = bits & exponentMask;
+        bits += (127U - 15U) << 23;
+        if(exponent == exponentMask) {
+            bits += (128U - 16U) << 23;  // infinity and NaN
+        } else if(exponent == 0) {
+            bits += 1U << 23;  // subnormal, renormalized through the float unit
+            bits = std::bit_cast<uint32_t>(std::bit_cast<float>(bits) - std::bit_cast<float>(113U << 23));
+        }
+        return std::bit_cast<float>(bits | (static_cast<uint32_t>(half & 0x8000U) << 16));
+    }
+
+    namespace detail {
+        /// Clamp written so that NaN lands on low, as _mm256_max_ps does.
+        [[nodiscard]] constexpr float clampOrLow(float value, float low, float high) noexcept {
+            return value >= low ? (value <= high ? value : high) : low;
+        }
+    }  // namespace detail
+
+    [[nodiscard]] inline int16_t toSnorm16(float value) noexcept {
+        return static_cast<int16_t>(std::nearbyint(detail::clampOrLow(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    [[nodiscard]] inline uint16_t toUnorm16(float value) noexcept {
+        return static_cast<uint16_t>(std::nearbyint(detail::clampOrLow(value, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    [[nodiscard]] inline uint8_t toUnorm8(float value) noexcept {
+        return static_cast<uint8_t>(std::nearbyint(detail::clampOrLow(value, 0.0f, 1.0f) * 255.0f));
+    }
+
+    /// Octahedral mapping of a unit vector to [-1, 1]^2, from Cigolle et al., "A Survey of Efficient Representations for
+    /// Independent Unit Vectors".
+    struct Octahedral {
+        float u;
+        float v;
+    };
+
+    [[nodiscard]] inline Octahedral toOctahedral(float x, float y, float z) noexcept {
+        // argument order makes NaN pick the floor, as _mm256_max_ps does
+        const float inverseNorm = 1.0f / std::max(1e-20f, std::abs(x) + std::abs(y) + std::abs(z));
+        const float u = x * inverseNorm;
+        const float v = y * inverseNorm;
+        if(z * inverseNorm < 0.0f) {
+            // lower hemisphere: fold over the diagonals
+            return {(1.0f - std::abs(v)) * std::copysign(1.0f, u), (1.0f - std::abs(u)) * std::copysign(1.0f, v)};
+        }
+        return {u, v};
+    }
+
+    /// Inverse of toOctahedral, normalized.
+    [[nodiscard]] inline std::array<float, 3> fromOctahedral(Octahedral encoded) noexcept {
+        float x = encoded.u;
+        float y = encoded.v;
+        const float z = 1.0f - std::abs(x) - std::abs(y);
+        const float fold = std::max(-z, 0.0f);
+        x += x >= 0.0f ? -fold : fold;
+        y += y >= 0.0f ? -fold : fold;
+        const float inverseLength = 1.0f / std::sqrt(x * x + y * y + z * z);
+        return {x * inverseLength, y * inverseLength, z * inverseLength};
+    }
+
+    inline void toHalf(std::span<const float> source, std::span<uint16_t> destination) noexcept {
+        std::size_t index = 0;
+#ifdef VKL_QUANTIZE_AVX2
+        for(; index + 8 <= source.size(); index += 8) {
+            const __m128i halves = _mm256_cvtps_ph(_mm256_loadu_ps(source.data() + index), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination.data() + index), halves);
+        }
+#endif
+        for(; index < source.size(); index++) { destination[index] = toHalf(source[index]); }
+    }
+
+#ifdef VKL_QUANTIZE_AVX2
+    namespace detail {
+        /// Eight clamped and scaled lanes rounded to int32, packed to 16 bit with signed or unsigned saturation.
+        template <bool Signed> [[nodiscard]] inline __m128i pack16(__m256 value, float low, float high, float scale) noexcept {
+            const __m256 clamped = _mm256_min_ps(_mm256_max_ps(value, _mm256_set1_ps(low)), _mm256_set1_ps(high));
+            const __m256i rounded = _mm256_cvtps_epi32(_mm256_mul_ps(clamped, _mm256_set1_ps(scale)));
+            const __m256i packed = Signed ? _mm256_packs_epi32(rounded, rounded) : _mm256_packus_epi32(rounded, rounded);
+            // packs works per 128 bit lane, gather the two useful quarters
+            return _mm256_castsi256_si128(_mm256_permute4x64_epi64(packed, 0x08));
+        }
+    }  // namespace detail
+#endif
+
+    inline void toSnorm16(std::span<const float> source, std::span<int16_t> destination) noexcept {
+        std::size_t index = 0;
+#ifdef VKL_QUANTIZE_AVX2
+        for(; index + 8 <= source.size(); index += 8) {
+            const __m128i packed = detail::pack16<true>(_mm256_loadu_ps(source.data() + index), -1.0f, 1.0f, 32767.0f);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination.data() + index), packed);
+        }
+#endif
+        for(; index < source.size(); index++) { destination[index] = toSnorm16(source[index]); }
+    }
+
+    inline void toUnorm16(std::span<const float> source, std::span<uint16_t> destination) noexcept {
+        std::size_t index = 0;
+#ifdef VKL_QUANTIZE_AVX2
+        for(; index + 8 <= source.size(); index += 8) {
+            const __m128i packed = detail::pack16<false>(_mm256_loadu_ps(source.data() + index), 0.0f, 1.0f, 65535.0f);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination.data() + index), packed);
+        }
+#endif
+        for(; index < source.size(); index++) { destination[index] = toUnorm16(source[index]); }
+    }
+
+    inline void toUnorm8(std::span<const float> source, std::span<uint8_t> destination) noexcept {
+        std::size_t index = 0;
+#ifdef VKL_QUANTIZE_AVX2
+        for(; index + 8 <= source.size(); index += 8) {
+            const __m128i words = detail::pack16<false>(_mm256_loadu_ps(source.data() + index), 0.0f, 1.0f, 255.0f);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(destination.data() + index), _mm_packus_epi16(words, words));
+        }
+#endif
+        for(; index < source.size(); index++) { destination[index] = toUnorm8(source[index]); }
+    }
+
+    /// toOctahedral over structure of arrays, all spans hold the same count.
+    inline void toOctahedral(std::span<const float> x, std::span<const float> y, std::span<const float> z, std::span<float> u,
+                             std::span<float> v) noexcept {
+        std::size_t index = 0;
+#ifdef VKL_QUANTIZE_AVX2
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const auto abs = [signMask](__m256 value) { return _mm256_andnot_ps(signMask, value); };
+        const auto copySignOfOne = [signMask, one](__m256 value) { return _mm256_or_ps(_mm256_and_ps(value, signMask), one); };
+        for(; index + 8 <= x.size(); index += 8) {
+            const __m256 vx = _mm256_loadu_ps(x.data() + index);
+            const __m256 vy = _mm256_loadu_ps(y.data() + index);
+            const __m256 vz = _mm256_loadu_ps(z.data() + index);
+            const __m256 norm = _mm256_max_ps(_mm256_add_ps(_mm256_add_ps(abs(vx), abs(vy)), abs(vz)), _mm256_set1_ps(1e-20f));
+            const __m256 inverseNorm = _mm256_div_ps(one, norm);
+            const __m256 pu = _mm256_mul_ps(vx, inverseNorm);
+            const __m256 pv = _mm256_mul_ps(vy, inverseNorm);
+            const __m256 lower = _mm256_cmp_ps(_mm256_mul_ps(vz, inverseNorm), _mm256_setzero_ps(), _CMP_LT_OQ);
+            const __m256 foldedU = _mm256_mul_ps(_mm256_sub_ps(one, abs(pv)), copySignOfOne(pu));
+            const __m256 foldedV = _mm256_mul_ps(_mm256_sub_ps(one, abs(pu)), copySignOfOne(pv));
+            _mm256_storeu_ps(u.data() + index, _mm256_blendv_ps(pu, foldedU, lower));
+            _mm256_storeu_ps(v.data() + index, _mm256_blendv_ps(pv, foldedV, lower));
+        }
+#endif
+        for(; index < x.size(); index++) {
+            const auto [encodedU, encodedV] = toOctahedral(x[index], y[index], z[index]);
+            u[index] = encodedU;
+            v[index] = encodedV;
+        }
+    }
+}  // namespace quantize
+/** @} */
+
+// NOLINTEND(*-magic-numbers, *-avoid-magic-numbers, *-reinterpret-cast, *-pointer-arithmetic)
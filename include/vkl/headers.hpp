@@ -18,7 +18,10 @@ DISABLE_WARNINGS_PUSH(
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <bit>
 #include <cassert>
+#include <cctype>
+#include <charconv>
 #include <complex>
 #include <chrono>
 #include <cmath>
@@ -44,6 +47,7 @@ DISABLE_WARNINGS_PUSH(
 #include <ranges>
 #include <set>
 #include <source_location>
+#include <span>
 #include <sstream>
 #include <stack>
 #include <stdexcept>
@@ -4,4 +4,5 @@
 #include "Log.hpp"
 #include "headers.hpp"
 #include "timer/Timer.hpp"
-#include "app.hpp"
\ No newline at end of file
+#include "app.hpp"
+#include "HeadlessApp.hpp"
\ No newline at end of file
@@ -0,0 +1,11 @@
+// Inverse of quantize::toOctahedral in cast/Quantize.hpp: the normal of Model::QuantizedVertex reaches the vertex
+// shader as the encoded vec2, a shader reading location 2 of that layout includes this file
+// (#extension GL_GOOGLE_include_directive : require) and decodes it with fromOctahedral.
+
+vec3 fromOctahedral(vec2 encoded) {
+  vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+  float fold = max(-normal.z, 0.0);
+  normal.x += normal.x >= 0.0 ? -fold : fold;
+  normal.y += normal.y >= 0.0 ? -fold : fold;
+  return normalize(normal);
+}
@@ -0,0 +1,26 @@
+#version 450
+
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 color;
+
+struct ObjectData {
+  mat4 transform;
+  uint meshId;
+  uint materialId;
+};
+
+// one entry per object, the indirect commands pass the object index as firstInstance
+layout (std430, set = 0, binding = 0) readonly buffer Objects {
+  ObjectData objects[];
+};
+
+layout (push_constant) uniform Camera {
+  mat4 viewProjection;
+} camera;
+
+layout (location = 0) out vec3 fragColor;
+
+void main() {
+  gl_Position = camera.viewProjection * objects[gl_InstanceIndex].transform * vec4(position, 1.0);
+  fragColor = color;
+}
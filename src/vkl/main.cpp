@@ -10,14 +10,43 @@
 
 // NOLINTBEGIN(*-owning-memory)
 // NOLINTNEXTLINE(bugprone-exception-escape)
-int main() {
+int main(int argc, const char *const argv[]) {
     INIT_LOG()
     LINFO("{} {}v", vkl::cmake::project_name, vkl::cmake::project_version);
     LINFO("{}", glfwGetVersionString());
     try {
-        lve::App app{};
+        // --device <index|uuid|name> overrides the automatic GPU selection (same syntax as VKL_DEVICE)
+        // --headless [frames] renders offscreen without a window or a surface
+        std::optional<std::size_t> headlessFrames;
+        const std::span args(argv, C_ST(argc));
+        for(auto it = args.begin(); it != args.end(); ++it) {
+            const std::string_view arg{*it};
+            if(arg == "--device" && std::next(it) != args.end()) {
+                lve::Device::setDeviceSelector(*++it);
+            } else if(arg.starts_with("--device=")) {
+                lve::Device::setDeviceSelector(arg.substr(std::string_view{"--device="}.size()));
+            } else if(arg == "--headless") {
+                headlessFrames = 1000;
+                if(std::next(it) != args.end()) {
+                    const std::string_view count{*std::next(it)};
+                    std::size_t frames = 0;
+                    if(std::from_chars(count.data(), count.data() + count.size(), frames).ec == std::errc{}) {
+                        headlessFrames = frames;
+                        ++it;
+                    }
+                }
+            }
+        }
 
-        app.run();
+        if(headlessFrames.has_value()) {
+            lve::HeadlessApp app{};
+
+            app.run(*headlessFrames);
+        } else {
+            lve::App app{};
+
+            app.run();
+        }
     } catch(const std::exception &e) { spdlog::error("Unhandled exception in main: {}", e.what()); }
 }
 
@@ -0,0 +1,65 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner, *-signed-bitwise)
+#include "vkl/ComputePipeline.hpp"
+
+#include "vkl/Pipeline.hpp"
+#include <vkl/timer/Timer.hpp>
+
+namespace lve {
+
+    ComputePipeline::ComputePipeline(Device &device, const std::string &compFilepath, VkPipelineLayout pipelineLayout)
+      : lveDevice{device} {
+        assert(pipelineLayout != VK_NULL_HANDLE && "Cannot create compute pipeline: no pipelineLayout provided");
+        const auto compCode = Pipeline::readFile(compFilepath);
+
+        VkShaderModuleCreateInfo moduleInfo{};
+        moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        moduleInfo.codeSize = compCode.size();
+        moduleInfo.pCode = C_CPCU32T(compCode.data());
+        VkShaderModule compShaderModule{};
+        VK_CHECK(vkCreateShaderModule(lveDevice.device(), &moduleInfo, nullptr, &compShaderModule), "failed to create shader module");
+
+        VkPipelineCreationFeedback pipelineFeedback{};
+        VkPipelineCreationFeedbackCreateInfo feedbackInfo{};
+        feedbackInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO;
+        feedbackInfo.pPipelineCreationFeedback = &pipelineFeedback;
+
+        VkComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.pNext = lveDevice.supportsPipelineCreationFeedback() ? &feedbackInfo : nullptr;
+        pipelineInfo.stage = VkPipelineShaderStageCreateInfo{.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+                                                             .pNext = nullptr,
+                                                             .flags = 0,
+                                                             .stage = VK_SHADER_STAGE_COMPUTE_BIT,
+                                                             .module = compShaderModule,
+                                                             .pName = "main",
+                                                             .pSpecializationInfo = nullptr};
+        pipelineInfo.layout = pipelineLayout;
+        pipelineInfo.basePipelineIndex = -1;
+        pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+
+        PipelineCache &cache = lveDevice.pipelineCache();
+        const VkResult result = [&] {
+            const vnd::AutoTimer timer(FORMAT("compute pipeline creation ({})", cache.isWarm() ? "warm cache" : "cold compile"));
+            return vkCreateComputePipelines(lveDevice.device(), cache.handle(), 1, &pipelineInfo, nullptr, &computePipeline);
+        }();
+        vkDestroyShaderModule(lveDevice.device(), compShaderModule, nullptr);
+        VK_CHECK(result, "failed to create compute pipeline");
+        if(pipelineFeedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT) {
+            LINFO("Compute pipeline: cache {}, driver time {} ns",
+                  pipelineFeedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT ? "hit" : "miss",
+                  pipelineFeedback.duration);
+        }
+    }
+
+    ComputePipeline::~ComputePipeline() { vkDestroyPipeline(lveDevice.device(), computePipeline, nullptr); }
+
+    void ComputePipeline::bind(VkCommandBuffer commandBuffer) const {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner, *-signed-bitwise)
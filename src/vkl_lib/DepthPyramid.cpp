@@ -0,0 +1,223 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#include "vkl/DepthPyramid.hpp"
+
+#include "vkl/Window.hpp"
+
+namespace lve {
+
+    DepthPyramid::DepthPyramid(Device &device, VkExtent2D depthExtent, VkImageView depthView)
+      : lveDevice{device}, depthExtent_{depthExtent},
+        extent_{.width = std::max((depthExtent.width + 1) / 2, 1U), .height = std::max((depthExtent.height + 1) / 2, 1U)} {
+        createImage();
+        createDescriptors(depthView);
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &setLayout;
+        VK_CHECK(vkCreatePipelineLayout(lveDevice.device(), &pipelineLayoutInfo, nullptr, &pipelineLayout),
+                 "failed to create depth pyramid pipeline layout!");
+        pipeline = MAKE_UNIQUE(ComputePipeline, lveDevice,
+                               Window::calculateRelativePathToSrcShaders(curentP, "depth_pyramid.comp.opt.rmp.spv").string(),
+                               pipelineLayout);
+    }
+
+    DepthPyramid::~DepthPyramid() {
+        const VkDevice device = lveDevice.device();
+        pipeline.reset();
+        vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+        vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+        vkDestroyDescriptorSetLayout(device, setLayout, nullptr);
+        vkDestroySampler(device, sampler_, nullptr);
+        for(VkImageView levelView : levelViews) { vkDestroyImageView(device, levelView, nullptr); }
+        vkDestroyImageView(device, fullView, nullptr);
+        lveDevice.destroyImage(image, imageAllocation);
+    }
+
+    void DepthPyramid::createImage() {
+        const auto levels = C_UI32T(std::bit_width(std::max(extent_.width, extent_.height)));
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent = {extent_.width, extent_.height, 1};
+        imageInfo.mipLevels = levels;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = VK_FORMAT_R32_SFLOAT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        lveDevice.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, image, imageAllocation);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = VK_FORMAT_R32_SFLOAT;
+        viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, levels, 0, 1};
+        VK_CHECK(vkCreateImageView(lveDevice.device(), &viewInfo, nullptr, &fullView), "failed to create depth pyramid view!");
+
+        // the descriptors name the image GENERAL, which they are bound as before the first build() writes it
+        VkImageMemoryBarrier toGeneral{};
+        toGeneral.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        toGeneral.srcAccessMask = 0;
+        toGeneral.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        toGeneral.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        toGeneral.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        toGeneral.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toGeneral.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toGeneral.image = image;
+        toGeneral.subresourceRange = viewInfo.subresourceRange;
+        VkCommandBuffer commandBuffer = lveDevice.beginSingleTimeCommands();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0,
+                             nullptr, 1, &toGeneral);
+        lveDevice.endSingleTimeCommands(commandBuffer);
+        levelViews.resize(levels);
+        for(uint32_t level = 0; level < levels; level++) {
+            viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, 1};
+            VK_CHECK(vkCreateImageView(lveDevice.device(), &viewInfo, nullptr, &levelViews[level]),
+                     "failed to create depth pyramid level view!");
+        }
+
+        // the shaders only use texelFetch, the sampler just has to exist
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_NEAREST;
+        samplerInfo.minFilter = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+        VK_CHECK(vkCreateSampler(lveDevice.device(), &samplerInfo, nullptr, &sampler_), "failed to create depth pyramid sampler!");
+    }
+
+    void DepthPyramid::createDescriptors(VkImageView depthView) {
+        const std::array<VkDescriptorSetLayoutBinding, 2> bindings{
+            VkDescriptorSetLayoutBinding{.binding = 0,
+                                         .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                         .descriptorCount = 1,
+                                         .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+                                         .pImmutableSamplers = nullptr},
+            VkDescriptorSetLayoutBinding{.binding = 1,
+                                         .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+                                         .descriptorCount = 1,
+                                         .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+                                         .pImmutableSamplers = nullptr}};
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = C_UI32T(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+        VK_CHECK(vkCreateDescriptorSetLayout(lveDevice.device(), &layoutInfo, nullptr, &setLayout),
+                 "failed to create depth pyramid descriptor set layout!");
+
+        const uint32_t levels = levelCount();
+        const std::array<VkDescriptorPoolSize, 2> poolSizes{
+            VkDescriptorPoolSize{.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .descriptorCount = levels},
+            VkDescriptorPoolSize{.type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, .descriptorCount = levels}};
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets = levels;
+        poolInfo.poolSizeCount = C_UI32T(poolSizes.size());
+        poolInfo.pPoolSizes = poolSizes.data();
+        VK_CHECK(vkCreateDescriptorPool(lveDevice.device(), &poolInfo, nullptr, &descriptorPool),
+                 "failed to create depth pyramid descriptor pool!");
+
+        const std::vector<VkDescriptorSetLayout> layouts(levels, setLayout);
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = levels;
+        allocInfo.pSetLayouts = layouts.data();
+        levelSets.resize(levels);
+        VK_CHECK(vkAllocateDescriptorSets(lveDevice.device(), &allocInfo, levelSets.data()),
+                 "failed to allocate depth pyramid descriptor sets!");
+
+        std::vector<VkDescriptorImageInfo> imageInfos;
+        imageInfos.reserve(C_ST(levels) * 2);
+        std::vector<VkWriteDescriptorSet> writes;
+        writes.reserve(C_ST(levels) * 2);
+        for(uint32_t level = 0; level < levels; level++) {
+            const VkDescriptorImageInfo &source = imageInfos.emplace_back(VkDescriptorImageInfo{
+                .sampler = sampler_,
+                .imageView = level == 0 ? depthView : levelViews[level - 1],
+                .imageLayout = level == 0 ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL});
+            const VkDescriptorImageInfo &destination = imageInfos.emplace_back(
+                VkDescriptorImageInfo{.sampler = VK_NULL_HANDLE, .imageView = levelViews[level], .imageLayout = VK_IMAGE_LAYOUT_GENERAL});
+
+            VkWriteDescriptorSet write{};
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet = levelSets[level];
+            write.descriptorCount = 1;
+            write.dstBinding = 0;
+            write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            write.pImageInfo = &source;
+            writes.emplace_back(write);
+            write.dstBinding = 1;
+            write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            write.pImageInfo = &destination;
+            writes.emplace_back(write);
+        }
+        vkUpdateDescriptorSets(lveDevice.device(), C_UI32T(writes.size()), writes.data(), 0, nullptr);
+    }
+
+    void DepthPyramid::build(VkCommandBuffer commandBuffer, VkImage depthImage, VkFormat depthFormat) const {
+        const VkImageAspectFlags depthAspect =
+            depthFormat == VK_FORMAT_D32_SFLOAT ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        const auto imageBarrier = [](VkImage target, VkImageAspectFlags aspect, VkAccessFlags srcAccess, VkAccessFlags dstAccess,
+                                     VkImageLayout oldLayout, VkImageLayout newLayout) {
+            VkImageMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcAccessMask = srcAccess;
+            barrier.dstAccessMask = dstAccess;
+            barrier.oldLayout = oldLayout;
+            barrier.newLayout = newLayout;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = target;
+            barrier.subresourceRange = {aspect, 0, VK_REMAINING_MIP_LEVELS, 0, 1};
+            return barrier;
+        };
+
+        // the previous contents are overwritten whole, but the previous frame's occlusion test may still read them
+        const std::array<VkImageMemoryBarrier, 2> toReduce{
+            imageBarrier(depthImage, depthAspect, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+                         VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL),
+            imageBarrier(image, VK_IMAGE_ASPECT_COLOR_BIT, 0, VK_ACCESS_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED,
+                         VK_IMAGE_LAYOUT_GENERAL)};
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, C_UI32T(toReduce.size()), toReduce.data());
+
+        pipeline->bind(commandBuffer);
+        for(uint32_t level = 0; level < levelCount(); level++) {
+            const uint32_t width = std::max(extent_.width >> level, 1U);
+            const uint32_t height = std::max(extent_.height >> level, 1U);
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &levelSets[level], 0, nullptr);
+            vkCmdDispatch(commandBuffer, ComputePipeline::groupCount(width, GROUP_SIZE), ComputePipeline::groupCount(height, GROUP_SIZE),
+                          1);
+
+            // each level reads the one written just before
+            const VkMemoryBarrier levelBarrier{.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                                               .pNext = nullptr,
+                                               .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+                                               .dstAccessMask = VK_ACCESS_SHADER_READ_BIT};
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1,
+                                 &levelBarrier, 0, nullptr, 0, nullptr);
+        }
+
+        const VkImageMemoryBarrier toAttachment = imageBarrier(
+            depthImage, depthAspect, 0, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, 0, 0, nullptr, 0,
+                             nullptr, 1, &toAttachment);
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
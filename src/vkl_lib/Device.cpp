@@ -1,6 +1,7 @@
 // NOLINTBEGIN(*-include-cleaner, *-use-anonymous-namespace, *-signed-bitwise, *-uppercase-literal-suffix,*-uppercase-literal-suffix
 #include "vkl/Device.hpp"
 
+#include "vkl/UploadEngine.hpp"
 #include "vkl/VlukanLogInfoCallback.hpp"
 
 namespace lve {
@@ -58,22 +59,34 @@ namespace lve {
     }
 
     // class member functions
-    Device::Device(Window &window) : window{window} {
+    Device::Device(Window &window) : Device(&window) {}
+
+    Device::Device() : Device(nullptr) {}
+
+    Device::Device(Window *windowPtr)
+      : window{windowPtr}, deviceExtensions{windowPtr != nullptr ? std::vector<const char *>{VK_KHR_SWAPCHAIN_EXTENSION_NAME}
+                                                                 : std::vector<const char *>{}} {
         createInstance();
         setupDebugMessenger();
-        createSurface();
+        if(!isHeadless()) { createSurface(); }
         pickPhysicalDevice();
         createLogicalDevice();
+        createAllocator();
+        createPipelineCache();
         createCommandPool();
+        uploader_ = MAKE_UNIQUE(UploadEngine, *this);
     }
 
     Device::~Device() {
+        uploader_.reset();
         vkDestroyCommandPool(device_, commandPool, nullptr);
+        pipelineCache_.reset();
+        allocator_.reset();
         vkDestroyDevice(device_, nullptr);
 
         if(enableValidationLayers) { DestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr); }
 
-        vkDestroySurfaceKHR(instance, surface_, nullptr);
+        if(surface_ != VK_NULL_HANDLE) { vkDestroySurfaceKHR(instance, surface_, nullptr); }
         vkDestroyInstance(instance, nullptr);
     }
 
@@ -213,6 +226,106 @@ namespace lve {
         // Add more properties as needed
     }
 
+    static std::string toLowerHex(std::span<const uint8_t> bytes) {
+        std::string hex;
+        hex.reserve(bytes.size() * 2);
+        for(const uint8_t byte : bytes) { hex += FORMAT("{:02x}", byte); }
+        return hex;
+    }
+
+    static std::string toLower(std::string_view text) {
+        std::string lower(text);
+        std::ranges::transform(lower, lower.begin(), [](unsigned char c) { return C_C(std::tolower(c)); });
+        return lower;
+    }
+
+    static bool matchesSelector(const DeviceCandidate &candidate, std::string_view selector) {
+        if(std::ranges::all_of(selector, [](unsigned char c) { return std::isdigit(c) != 0; })) {
+            uint32_t index = 0;
+            const auto [ptr, ec] = std::from_chars(selector.data(), selector.data() + selector.size(), index);
+            return ec == std::errc{} && index == candidate.index;
+        }
+
+        std::string uuid = toLower(selector);
+        std::erase(uuid, '-');
+        if(uuid.size() == C_ST(VK_UUID_SIZE) * 2 && std::ranges::all_of(uuid, [](unsigned char c) { return std::isxdigit(c) != 0; })) {
+            return uuid == toLowerHex(candidate.deviceUUID) || uuid == toLowerHex(candidate.properties.pipelineCacheUUID);
+        }
+
+        return toLower(candidate.properties.deviceName).contains(toLower(selector));
+    }
+
+    DeviceCandidate Device::rateDevice(VkPhysicalDevice device, uint32_t index) {
+        DeviceCandidate candidate{.device = device, .index = index};
+
+        VkPhysicalDeviceIDProperties idProperties{};
+        idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+        VkPhysicalDeviceProperties2 properties2{};
+        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties2.pNext = &idProperties;
+        vkGetPhysicalDeviceProperties2(device, &properties2);
+        candidate.properties = properties2.properties;
+        std::ranges::copy(idProperties.deviceUUID, candidate.deviceUUID.begin());
+
+        VkPhysicalDeviceMemoryProperties memProperties;
+        vkGetPhysicalDeviceMemoryProperties(device, &memProperties);
+        for(const auto &heap : std::span(memProperties.memoryHeaps, memProperties.memoryHeapCount)) {
+            if(heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) { candidate.deviceLocalBytes = std::max(candidate.deviceLocalBytes, heap.size); }
+        }
+
+        candidate.suitable = isDeviceSuitable(device);
+        if(!candidate.suitable) { return candidate; }
+
+        // the device type dominates, everything else only breaks ties between devices of the same kind;
+        // software implementations (lavapipe, swiftshader) keep a non zero score so they are still picked when alone
+        switch(candidate.properties.deviceType) {
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+            candidate.score += 4000;
+            break;
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+            candidate.score += 2000;
+            break;
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+            candidate.score += 1000;
+            break;
+        case VK_PHYSICAL_DEVICE_TYPE_CPU:
+            candidate.score += 100;
+            break;
+        default:
+            break;
+        }
+
+        // one point per 64MiB, capped below the gap between device types: a CPU implementation reports host RAM as device local
+        candidate.score += std::min<uint64_t>(candidate.deviceLocalBytes >> 26, 99);
+
+        uint32_t extensionCount = 0;
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+        std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
+        for(const char *optional : optionalDeviceExtensions) {
+            if(std::ranges::any_of(availableExtensions, [optional](const auto &ext) { return strcmp(ext.extensionName, optional) == 0; })) {
+                candidate.score += 50;
+            }
+        }
+
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilies.data());
+        if(findQueueFamilies(device).hasDedicatedTransfer()) { candidate.score += 200; }
+        if(std::ranges::any_of(queueFamilies, [](const VkQueueFamilyProperties &family) {
+               return (family.queueFlags & VK_QUEUE_COMPUTE_BIT) && !(family.queueFlags & VK_QUEUE_GRAPHICS_BIT);
+           })) {
+            candidate.score += 100;
+        }
+
+        const VkPhysicalDeviceLimits &limits = candidate.properties.limits;
+        candidate.score += limits.maxImageDimension2D / 1024;
+        candidate.score += limits.maxComputeSharedMemorySize / 4096;
+        candidate.score += limits.maxPushConstantsSize / 64;
+        return candidate;
+    }
+
     void Device::pickPhysicalDevice() {
         uint32_t deviceCount = 0;
         vkEnumeratePhysicalDevices(instance, &deviceCount, nullptr);
@@ -220,11 +333,40 @@ namespace lve {
         std::vector<VkPhysicalDevice> devices(deviceCount);
         vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
 
-        physicalDevice = *std::ranges::find_if(devices, [this](const VkPhysicalDevice &device) { return isDeviceSuitable(device); });
+        std::vector<DeviceCandidate> candidates;
+        candidates.reserve(deviceCount);
+        for(auto &&[index, device] : std::views::enumerate(devices)) { candidates.emplace_back(rateDevice(device, C_UI32T(index))); }
+        std::ranges::stable_sort(candidates, std::ranges::greater{}, [](const DeviceCandidate &c) { return std::pair{c.suitable, c.score}; });
+
+        std::string selector = deviceSelector;
+        // NOLINTNEXTLINE(*-mt-unsafe)
+        if(const char *env = std::getenv("VKL_DEVICE"); selector.empty() && env != nullptr) { selector = env; }
+
+        const DeviceCandidate *chosen = nullptr;
+        if(!selector.empty()) {
+            const auto it = std::ranges::find_if(candidates, [&selector](const DeviceCandidate &c) { return matchesSelector(c, selector); });
+            if(it == candidates.end()) [[unlikely]] { throw std::runtime_error(FORMAT("no GPU matches the device selector '{}'!", selector)); }
+            if(!it->suitable) [[unlikely]] {
+                throw std::runtime_error(FORMAT("the GPU '{}' selected by '{}' is not suitable!", it->properties.deviceName, selector));
+            }
+            chosen = &*it;
+        } else if(candidates.front().suitable) {
+            chosen = &candidates.front();
+        }
+
+        std::vector<std::string> rows;
+        rows.reserve(candidates.size());
+        for(const auto &candidate : candidates) {
+            rows.emplace_back(FORMAT("{} [{}] {:<40} {:<14} {:>6} MiB  score {:>5}  uuid {}", &candidate == chosen ? '*' : ' ',
+                                     candidate.index, std::string_view(candidate.properties.deviceName),
+                                     getDeviceType(candidate.properties.deviceType), candidate.deviceLocalBytes >> 20,
+                                     candidate.suitable ? FORMAT("{}", candidate.score) : "n/a", toLowerHex(candidate.deviceUUID)));
+        }
+        LINFO("Physical devices ({}){}:\n{}", deviceCount, selector.empty() ? "" : FORMAT(" selected by '{}'", selector), FMT_JOIN(rows, "\n"));
 
-        if(physicalDevice == VK_NULL_HANDLE) [[unlikely]] { throw std::runtime_error("failed to find a suitable GPU!"); }
-        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
-        LINFO("Dev count: {}", deviceCount);
+        if(chosen == nullptr) [[unlikely]] { throw std::runtime_error("failed to find a suitable GPU!"); }
+        physicalDevice = chosen->device;
+        properties = chosen->properties;
         printPhysicalDeviceProperties(properties);
     }
 
@@ -232,7 +374,8 @@ namespace lve {
         QueueFamilyIndices indices = findQueueFamilies(physicalDevice);
 
         std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-        std::set<uint32_t> uniqueQueueFamilies = {indices.graphicsFamily, indices.presentFamily};
+        std::set<uint32_t> uniqueQueueFamilies = {indices.graphicsFamily, indices.transferFamily};
+        if(indices.presentFamilyHasValue) { uniqueQueueFamilies.insert(indices.presentFamily); }
 
         constexpr float queuePriority = 1.0f;
         for(const uint32_t queueFamily : uniqueQueueFamilies) {
@@ -242,16 +385,49 @@ namespace lve {
                                                                   .pQueuePriorities = &queuePriority});
         }
 
-        VkPhysicalDeviceFeatures deviceFeatures = {};
-        deviceFeatures.samplerAnisotropy = VK_TRUE;
+        // dynamic rendering is core in 1.3 and optional here, render pass objects remain the fallback; the indirect draw
+        // features are optional too, GpuScene falls back to fewer or per-command indirect draws without them
+        VkPhysicalDeviceVulkan13Features supported13{};
+        supported13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+        VkPhysicalDeviceVulkan12Features supported12{};
+        supported12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        supported12.pNext = properties.apiVersion >= VK_API_VERSION_1_3 ? &supported13 : nullptr;
+        VkPhysicalDeviceFeatures2 supported{};
+        supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        supported.pNext = &supported12;
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &supported);
+        dynamicRendering_ = supported13.dynamicRendering == VK_TRUE;
+        multiDrawIndirect_ = supported.features.multiDrawIndirect == VK_TRUE;
+        drawIndirectFirstInstance_ = supported.features.drawIndirectFirstInstance == VK_TRUE;
+        drawIndirectCount_ = supported12.drawIndirectCount == VK_TRUE;
+        // core in 1.3, VK_EXT_pipeline_creation_feedback is not enabled on older devices
+        pipelineCreationFeedback_ = properties.apiVersion >= VK_API_VERSION_1_3;
+
+        VkPhysicalDeviceVulkan13Features vulkan13Features{};
+        vulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+        vulkan13Features.dynamicRendering = dynamicRendering_ ? VK_TRUE : VK_FALSE;
+
+        VkPhysicalDeviceVulkan12Features vulkan12Features{};
+        vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        vulkan12Features.pNext = dynamicRendering_ ? &vulkan13Features : nullptr;
+        vulkan12Features.timelineSemaphore = VK_TRUE;
+        vulkan12Features.drawIndirectCount = drawIndirectCount_ ? VK_TRUE : VK_FALSE;
+
+        VkPhysicalDeviceFeatures2 deviceFeatures{};
+        deviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        deviceFeatures.pNext = &vulkan12Features;
+        deviceFeatures.features.samplerAnisotropy = VK_TRUE;
+        deviceFeatures.features.multiDrawIndirect = multiDrawIndirect_ ? VK_TRUE : VK_FALSE;
+        deviceFeatures.features.drawIndirectFirstInstance = drawIndirectFirstInstance_ ? VK_TRUE : VK_FALSE;
 
         VkDeviceCreateInfo createInfo = {};
         createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        createInfo.pNext = &deviceFeatures;
 
         createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
         createInfo.pQueueCreateInfos = queueCreateInfos.data();
 
-        createInfo.pEnabledFeatures = &deviceFeatures;
+        createInfo.pEnabledFeatures = nullptr;
         createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
         createInfo.ppEnabledExtensionNames = deviceExtensions.data();
 
@@ -276,7 +452,19 @@ namespace lve {
         VK_CHECK(vkCreateDevice(physicalDevice, &createInfo, nullptr, &device_), "failed to create logical device!");
 
         vkGetDeviceQueue(device_, indices.graphicsFamily, 0, &graphicsQueue_);
-        vkGetDeviceQueue(device_, indices.presentFamily, 0, &presentQueue_);
+        if(indices.presentFamilyHasValue) { vkGetDeviceQueue(device_, indices.presentFamily, 0, &presentQueue_); }
+        vkGetDeviceQueue(device_, indices.transferFamily, 0, &transferQueue_);
+    }
+
+    void Device::createAllocator() {
+        allocator_ = MAKE_UNIQUE(MemoryAllocator, physicalDevice, device_, properties.limits.bufferImageGranularity);
+    }
+
+    void Device::createPipelineCache() {
+        fs::path cachePath = curentP / "vkl_pipeline_cache.bin";
+        // NOLINTNEXTLINE(*-mt-unsafe)
+        if(const char *env = std::getenv("VKL_PIPELINE_CACHE"); env != nullptr) { cachePath = env; }
+        pipelineCache_ = MAKE_UNIQUE(PipelineCache, device_, properties, cachePath);
     }
 
     void Device::createCommandPool() {
@@ -290,15 +478,16 @@ namespace lve {
         VK_CHECK(vkCreateCommandPool(device_, &poolInfo, nullptr, &commandPool), "failed to create command pool!");
     }
 
-    void Device::createSurface() { window.createWindowSurface(instance, &surface_); }
+    void Device::createSurface() { window->createWindowSurface(instance, &surface_); }
 
     bool Device::isDeviceSuitable(VkPhysicalDevice device) {
         QueueFamilyIndices indices = findQueueFamilies(device);
 
         bool extensionsSupported = checkDeviceExtensionSupport(device);
 
-        bool swapChainAdequate = false;
-        if(extensionsSupported) {
+        // a headless device never presents, so it does not need a surface to be compatible with
+        bool swapChainAdequate = isHeadless();
+        if(extensionsSupported && !isHeadless()) {
             SwapChainSupportDetails swapChainSupport = querySwapChainSupport(device);
             swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
         }
@@ -306,7 +495,12 @@ namespace lve {
         VkPhysicalDeviceFeatures supportedFeatures;
         vkGetPhysicalDeviceFeatures(device, &supportedFeatures);
 
-        return indices.isComplete() && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy;
+        // timeline semaphores (upload engine) are core in Vulkan 1.2
+        VkPhysicalDeviceProperties deviceProperties;
+        vkGetPhysicalDeviceProperties(device, &deviceProperties);
+        const bool apiSupported = deviceProperties.apiVersion >= VK_API_VERSION_1_2;
+
+        return indices.isComplete(!isHeadless()) && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy && apiSupported;
     }
 
     void Device::populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT &createInfo) {
@@ -350,11 +544,14 @@ namespace lve {
     }
 
     std::vector<const char *> Device::getRequiredExtensions() {
-        uint32_t glfwExtensionCount = 0;
-        const char **glfwExtensions;
-        glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-
-        std::vector<const char *> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+        std::vector<const char *> extensions;
+        // GLFW is never initialized for a headless device, its surface extensions are not needed anyway
+        if(!isHeadless()) {
+            uint32_t glfwExtensionCount = 0;
+            const char **glfwExtensions;
+            glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+            extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+        }
 
         if(enableValidationLayers) { extensions.emplace_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME); }
 
@@ -410,23 +607,35 @@ namespace lve {
         std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
         vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilies.data());
 
-        int i = 0;
+        uint32_t i = 0;
+        std::optional<uint32_t> transferOnly;
+        std::optional<uint32_t> transferNoGraphics;
         for(const auto &queueFamily : queueFamilies) {
-            if(queueFamily.queueCount > 0 && queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+            if(queueFamily.queueCount > 0 && queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT && !indices.graphicsFamilyHasValue) {
                 indices.graphicsFamily = i;
                 indices.graphicsFamilyHasValue = true;
             }
             VkBool32 presentSupport = false;
-            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface_, &presentSupport);
-            if(queueFamily.queueCount > 0 && presentSupport) {
+            if(surface_ != VK_NULL_HANDLE) { vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface_, &presentSupport); }
+            if(queueFamily.queueCount > 0 && presentSupport && !indices.presentFamilyHasValue) {
                 indices.presentFamily = i;
                 indices.presentFamilyHasValue = true;
             }
-            if(indices.isComplete()) { break; }
+            // prefer a pure DMA family, then any transfer capable family that is not the graphics one
+            const bool transfer = queueFamily.queueCount > 0 && queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT;
+            const bool graphics = queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT;
+            const bool compute = queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT;
+            if(transfer && !graphics && !compute && !transferOnly) { transferOnly = i; }
+            if(transfer && !graphics && !transferNoGraphics) { transferNoGraphics = i; }
 
             i++;
         }
 
+        if(indices.graphicsFamilyHasValue) {
+            indices.transferFamily = transferOnly.value_or(transferNoGraphics.value_or(indices.graphicsFamily));
+            indices.transferFamilyHasValue = true;
+        }
+
         return indices;
     }
 
@@ -467,18 +676,11 @@ namespace lve {
     }
 
     uint32_t Device::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags dproperties) {
-        VkPhysicalDeviceMemoryProperties memProperties;
-        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
-        const std::bitset<32> typeBits(typeFilter);
-        for(uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-            if(typeBits.test(i) && (memProperties.memoryTypes[i].propertyFlags & dproperties) == dproperties) { return i; }
-        }
-
-        throw std::runtime_error("failed to find suitable memory type!");
+        return allocator_->findMemoryType(typeFilter, dproperties);
     }
 
     void Device::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags dproperties, VkBuffer &buffer,
-                              VkDeviceMemory &bufferMemory) {
+                              Allocation &bufferAllocation) {
         VkBufferCreateInfo bufferInfo{};
         bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
         bufferInfo.size = size;
@@ -490,14 +692,15 @@ namespace lve {
         VkMemoryRequirements memRequirements;
         vkGetBufferMemoryRequirements(device_, buffer, &memRequirements);
 
-        VkMemoryAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.allocationSize = memRequirements.size;
-        allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, dproperties);
+        bufferAllocation = allocator_->allocate(memRequirements, dproperties, ResourceKind::Linear);
 
-        VK_CHECK(vkAllocateMemory(device_, &allocInfo, nullptr, &bufferMemory), "failed to allocate vertex buffer memory!");
+        VK_CHECK(vkBindBufferMemory(device_, buffer, bufferAllocation.memory, bufferAllocation.offset), "failed to bind buffer memory!");
+    }
 
-        vkBindBufferMemory(device_, buffer, bufferMemory, 0);
+    void Device::destroyBuffer(VkBuffer &buffer, Allocation &bufferAllocation) {
+        vkDestroyBuffer(device_, buffer, nullptr);
+        buffer = VK_NULL_HANDLE;
+        allocator_->free(bufferAllocation);
     }
 
     VkCommandBuffer Device::beginSingleTimeCommands() {
@@ -526,59 +729,44 @@ namespace lve {
         submitInfo.commandBufferCount = 1;
         submitInfo.pCommandBuffers = &commandBuffer;
 
-        vkQueueSubmit(graphicsQueue_, 1, &submitInfo, VK_NULL_HANDLE);
-        vkQueueWaitIdle(graphicsQueue_);
+        // wait on this submission only instead of idling the whole graphics queue
+        VkFenceCreateInfo fenceInfo{};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        VkFence fence = VK_NULL_HANDLE;
+        VK_CHECK(vkCreateFence(device_, &fenceInfo, nullptr, &fence), "failed to create single time command fence!");
 
+        VK_CHECK(vkQueueSubmit(graphicsQueue_, 1, &submitInfo, fence), "failed to submit single time command buffer!");
+        vkWaitForFences(device_, 1, &fence, VK_TRUE, MAXU64);
+
+        vkDestroyFence(device_, fence, nullptr);
         vkFreeCommandBuffers(device_, commandPool, 1, &commandBuffer);
     }
 
     void Device::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size) {
-        VkCommandBuffer commandBuffer = beginSingleTimeCommands();
-
-        VkBufferCopy copyRegion{};
-        copyRegion.srcOffset = 0;  // Optional
-        copyRegion.dstOffset = 0;  // Optional
-        copyRegion.size = size;
-        vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
-
-        endSingleTimeCommands(commandBuffer);
+        uploader_->wait(uploader_->copyBuffer(srcBuffer, dstBuffer, size));
     }
 
     void Device::copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height, uint32_t layerCount) {
-        VkCommandBuffer commandBuffer = beginSingleTimeCommands();
-
-        VkBufferImageCopy region{};
-        region.bufferOffset = 0;
-        region.bufferRowLength = 0;
-        region.bufferImageHeight = 0;
-
-        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        region.imageSubresource.mipLevel = 0;
-        region.imageSubresource.baseArrayLayer = 0;
-        region.imageSubresource.layerCount = layerCount;
-
-        region.imageOffset = {0, 0, 0};
-        region.imageExtent = {width, height, 1};
-
-        vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-        endSingleTimeCommands(commandBuffer);
+        uploader_->wait(uploader_->copyBufferToImage(buffer, image, width, height, layerCount));
     }
 
     void Device::createImageWithInfo(const VkImageCreateInfo &imageInfo, VkMemoryPropertyFlags dproperties, VkImage &image,
-                                     VkDeviceMemory &imageMemory) {
+                                     Allocation &imageAllocation, VkMemoryPropertyFlags preferred) {
         if(vkCreateImage(device_, &imageInfo, nullptr, &image) != VK_SUCCESS) { throw std::runtime_error("failed to create image!"); }
 
         VkMemoryRequirements memRequirements;
         vkGetImageMemoryRequirements(device_, image, &memRequirements);
 
-        VkMemoryAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.allocationSize = memRequirements.size;
-        allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, dproperties);
+        const auto kind = imageInfo.tiling == VK_IMAGE_TILING_LINEAR ? ResourceKind::Linear : ResourceKind::Optimal;
+        imageAllocation = allocator_->allocate(memRequirements, dproperties, kind, preferred);
 
-        VK_CHECK(vkAllocateMemory(device_, &allocInfo, nullptr, &imageMemory), "failed to allocate image memory!");
+        VK_CHECK(vkBindImageMemory(device_, image, imageAllocation.memory, imageAllocation.offset), "failed to bind image memory!");
+    }
 
-        VK_CHECK(vkBindImageMemory(device_, image, imageMemory, 0), "failed to bind image memory!");
+    void Device::destroyImage(VkImage &image, Allocation &imageAllocation) {
+        vkDestroyImage(device_, image, nullptr);
+        image = VK_NULL_HANDLE;
+        allocator_->free(imageAllocation);
     }
 
 }  // namespace lve
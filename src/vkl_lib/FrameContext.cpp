@@ -0,0 +1,96 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#include "vkl/FrameContext.hpp"
+
+namespace lve {
+
+    FrameContext::FrameContext(Device &device, std::size_t frameCount, uint32_t threadCount)
+      : lveDevice{device}, frameCount_{frameCount}, threadCount_{threadCount}, pools(frameCount * threadCount) {
+        if(frameCount == 0 || threadCount == 0) [[unlikely]] {
+            throw std::invalid_argument("a frame context needs at least one frame and one thread");
+        }
+
+        // TRANSIENT: buffers are short lived, and no RESET_COMMAND_BUFFER since the whole pool is reset at once
+        VkCommandPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.queueFamilyIndex = lveDevice.findPhysicalQueueFamilies().graphicsFamily;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        for(auto &threadPool : pools) {
+            VK_CHECK(vkCreateCommandPool(lveDevice.device(), &poolInfo, nullptr, &threadPool.pool), "failed to create frame command pool!");
+        }
+        LINFO("Frame context: {} frames x {} threads command pools", frameCount_, threadCount_);
+    }
+
+    FrameContext::~FrameContext() {
+        // destroying a pool frees its command buffers
+        for(const auto &threadPool : pools) { vkDestroyCommandPool(lveDevice.device(), threadPool.pool, nullptr); }
+    }
+
+    void FrameContext::beginFrame(std::size_t frameIndex) {
+        frameIndex_ = frameIndex % frameCount_;
+        for(uint32_t thread = 0; thread < threadCount_; thread++) {
+            ThreadCommands &threadPool = poolOf(frameIndex_, thread);
+            if(threadPool.primaryUsed == 0 && threadPool.secondaryUsed == 0) { continue; }
+            VK_CHECK(vkResetCommandPool(lveDevice.device(), threadPool.pool, 0), "failed to reset frame command pool!");
+            threadPool.primaryUsed = 0;
+            threadPool.secondaryUsed = 0;
+        }
+    }
+
+    VkCommandBuffer FrameContext::commandBuffer(uint32_t thread, VkCommandBufferLevel level) {
+        assert(thread < threadCount_ && "thread index out of range");
+        ThreadCommands &threadPool = poolOf(frameIndex_, thread);
+        const bool primary = level == VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        auto &buffers = primary ? threadPool.primary : threadPool.secondary;
+        auto &used = primary ? threadPool.primaryUsed : threadPool.secondaryUsed;
+
+        // only grows until the busiest frame has been seen once
+        if(used == buffers.size()) [[unlikely]] {
+            VkCommandBufferAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.commandPool = threadPool.pool;
+            allocInfo.level = level;
+            allocInfo.commandBufferCount = 1;
+            VkCommandBuffer buffer = VK_NULL_HANDLE;
+            VK_CHECK(vkAllocateCommandBuffers(lveDevice.device(), &allocInfo, &buffer), "failed to allocate frame command buffer!");
+            buffers.push_back(buffer);
+        }
+        return buffers[used++];
+    }
+
+    std::span<const VkCommandBuffer> FrameContext::recordSecondary(ThreadPool &pool, const VkCommandBufferInheritanceInfo &inheritance,
+                                                                   std::size_t itemCount, const ChunkRecorder &recordChunk) {
+        if(pool.threadCount() > threadCount_) [[unlikely]] {
+            throw std::invalid_argument(
+                FORMAT("thread pool has {} threads but the frame context only {}", pool.threadCount(), threadCount_));
+        }
+        if(itemCount == 0) { return {}; }
+
+        const std::size_t maxChunks = std::max(itemCount / MIN_ITEMS_PER_CHUNK, std::size_t{1});
+        const std::size_t targetChunks = std::min(maxChunks, std::size_t{pool.threadCount()} * CHUNKS_PER_THREAD);
+        const std::size_t chunkSize = (itemCount + targetChunks - 1) / targetChunks;
+        const std::size_t chunkCount = (itemCount + chunkSize - 1) / chunkSize;
+        secondaries.resize(chunkCount);
+
+        pool.parallelFor(chunkCount, [&](std::size_t chunk, uint32_t thread) {
+            VkCommandBuffer secondary = commandBuffer(thread, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+            VkCommandBufferBeginInfo beginInfo{};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            beginInfo.pInheritanceInfo = &inheritance;
+            VK_CHECK(vkBeginCommandBuffer(secondary, &beginInfo), "failed to begin recording secondary command buffer!");
+
+            const std::size_t first = chunk * chunkSize;
+            recordChunk(secondary, first, std::min(chunkSize, itemCount - first));
+
+            VK_CHECK(vkEndCommandBuffer(secondary), "failed to record secondary command buffer!");
+            secondaries[chunk] = secondary;
+        });
+        return secondaries;
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
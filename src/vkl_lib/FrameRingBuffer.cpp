@@ -0,0 +1,46 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#include "vkl/FrameRingBuffer.hpp"
+
+namespace lve {
+
+    static constexpr VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) noexcept {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    FrameRingBuffer::FrameRingBuffer(Device &device, VkDeviceSize bytesPerFrame, std::size_t frameCount, VkBufferUsageFlags usage)
+      : lveDevice{device}, frameCount_{frameCount} {
+        const auto &limits = lveDevice.properties.limits;
+        minAlignment = std::max({limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment, VkDeviceSize{16}});
+        regionSize_ = alignUp(bytesPerFrame, minAlignment);
+
+        lveDevice.createBuffer(regionSize_ * frameCount_, usage, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                               buffer, allocation);
+        if(allocation.mapped == nullptr) [[unlikely]] { throw std::runtime_error("frame ring buffer memory is not host visible!"); }
+        LINFO("Frame ring buffer: {} regions of {} bytes, alignment {}", frameCount_, regionSize_, minAlignment);
+    }
+
+    FrameRingBuffer::~FrameRingBuffer() { lveDevice.destroyBuffer(buffer, allocation); }
+
+    void FrameRingBuffer::beginFrame(std::size_t frameIndex) noexcept {
+        regionBase = regionSize_ * (frameIndex % frameCount_);
+        head = 0;
+    }
+
+    RingAllocation FrameRingBuffer::allocate(VkDeviceSize size, VkDeviceSize alignment) {
+        const VkDeviceSize offset = alignUp(head, std::max(alignment, minAlignment));
+        if(offset + size > regionSize_) [[unlikely]] {
+            throw std::runtime_error(FORMAT("frame ring buffer exhausted: {} bytes requested, {} of {} used", size, head, regionSize_));
+        }
+        head = offset + size;
+        return RingAllocation{.buffer = buffer,
+                              .offset = regionBase + offset,
+                              .size = size,
+                              .data = static_cast<std::byte *>(allocation.mapped) + regionBase + offset};
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
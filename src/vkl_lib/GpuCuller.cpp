@@ -0,0 +1,137 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#include "vkl/GpuCuller.hpp"
+
+#include "vkl/Window.hpp"
+
+namespace lve {
+
+    GpuCuller::GpuCuller(Device &device, const GpuScene &gpuScene, std::size_t framesInFlight)
+      : lveDevice{device}, scene{gpuScene}, slotObjects(framesInFlight, 0) {
+        if(scene.drawCommandBuffer() == VK_NULL_HANDLE) [[unlikely]] { throw std::logic_error("GpuCuller needs a built GpuScene"); }
+        createDescriptors();
+        createPipelineLayout();
+        pipeline = MAKE_UNIQUE(ComputePipeline, lveDevice,
+                               Window::calculateRelativePathToSrcShaders(curentP, "cull.comp.opt.rmp.spv").string(), pipelineLayout);
+
+        lveDevice.createBuffer(VkDeviceSize{sizeof(uint32_t)} * framesInFlight, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, readbackBuffer,
+                               readbackAllocation);
+    }
+
+    GpuCuller::~GpuCuller() {
+        lveDevice.destroyBuffer(readbackBuffer, readbackAllocation);
+        pipeline.reset();
+        vkDestroyPipelineLayout(lveDevice.device(), pipelineLayout, nullptr);
+        vkDestroyDescriptorPool(lveDevice.device(), descriptorPool, nullptr);
+        vkDestroyDescriptorSetLayout(lveDevice.device(), setLayout, nullptr);
+    }
+
+    void GpuCuller::createDescriptors() {
+        // objects, meshes, draw commands, draw count
+        const std::array<VkBuffer, 4> buffers{scene.objectBuffer(), scene.meshBuffer(), scene.drawCommandBuffer(), scene.drawCountBuffer()};
+
+        std::array<VkDescriptorSetLayoutBinding, 4> bindings{};
+        for(uint32_t binding = 0; binding < C_UI32T(bindings.size()); binding++) {
+            bindings[binding] = VkDescriptorSetLayoutBinding{.binding = binding,
+                                                             .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                                             .descriptorCount = 1,
+                                                             .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+                                                             .pImmutableSamplers = nullptr};
+        }
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = C_UI32T(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+        VK_CHECK(vkCreateDescriptorSetLayout(lveDevice.device(), &layoutInfo, nullptr, &setLayout),
+                 "failed to create cull descriptor set layout!");
+
+        const VkDescriptorPoolSize poolSize{.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .descriptorCount = C_UI32T(bindings.size())};
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets = 1;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+        VK_CHECK(vkCreateDescriptorPool(lveDevice.device(), &poolInfo, nullptr, &descriptorPool), "failed to create cull descriptor pool!");
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &setLayout;
+        VK_CHECK(vkAllocateDescriptorSets(lveDevice.device(), &allocInfo, &descriptorSet), "failed to allocate cull descriptor set!");
+
+        std::array<VkDescriptorBufferInfo, 4> bufferInfos{};
+        std::array<VkWriteDescriptorSet, 4> writes{};
+        for(uint32_t binding = 0; binding < C_UI32T(writes.size()); binding++) {
+            bufferInfos[binding] = VkDescriptorBufferInfo{.buffer = buffers[binding], .offset = 0, .range = VK_WHOLE_SIZE};
+            writes[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[binding].dstSet = descriptorSet;
+            writes[binding].dstBinding = binding;
+            writes[binding].descriptorCount = 1;
+            writes[binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[binding].pBufferInfo = &bufferInfos[binding];
+        }
+        vkUpdateDescriptorSets(lveDevice.device(), C_UI32T(writes.size()), writes.data(), 0, nullptr);
+    }
+
+    void GpuCuller::createPipelineLayout() {
+        const VkPushConstantRange pushRange{.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT, .offset = 0, .size = sizeof(PushConstants)};
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &setLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushRange;
+        VK_CHECK(vkCreatePipelineLayout(lveDevice.device(), &pipelineLayoutInfo, nullptr, &pipelineLayout),
+                 "failed to create cull pipeline layout!");
+    }
+
+    void GpuCuller::record(VkCommandBuffer commandBuffer, std::size_t frameIndex, const Frustum &frustum) {
+        const std::size_t slot = frameIndex % slotObjects.size();
+        const uint32_t objectCount = scene.objectCount();
+        const VkBuffer drawBuffer = scene.drawCommandBuffer();
+        const VkBuffer countBuffer = scene.drawCountBuffer();
+
+        const auto memoryBarrier = [commandBuffer](VkPipelineStageFlags srcStage, VkAccessFlags srcAccess, VkPipelineStageFlags dstStage,
+                                                   VkAccessFlags dstAccess) {
+            const VkMemoryBarrier barrier{
+                .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER, .pNext = nullptr, .srcAccessMask = srcAccess, .dstAccessMask = dstAccess};
+            vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+        };
+
+        // the draws and the stats copy of the previous frame still read what is rewritten here
+        memoryBarrier(VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                      VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0);
+        vkCmdFillBuffer(commandBuffer, countBuffer, 0, sizeof(uint32_t), 0);
+        if(!scene.drawsWithCount()) { vkCmdFillBuffer(commandBuffer, drawBuffer, 0, VK_WHOLE_SIZE, 0); }
+        memoryBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                      VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+        PushConstants constants{.planes = frustum.planes, .objectCount = objectCount};
+        pipeline->bind(commandBuffer);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+        vkCmdDispatch(commandBuffer, ComputePipeline::groupCount(objectCount, GROUP_SIZE), 1, 1);
+
+        memoryBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                      VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                      VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT);
+        const VkBufferCopy copy{.srcOffset = 0, .dstOffset = VkDeviceSize{sizeof(uint32_t)} * slot, .size = sizeof(uint32_t)};
+        vkCmdCopyBuffer(commandBuffer, countBuffer, readbackBuffer, 1, &copy);
+        memoryBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_HOST_BIT, VK_ACCESS_HOST_READ_BIT);
+        slotObjects[slot] = objectCount;
+    }
+
+    std::optional<GpuCuller::Stats> GpuCuller::stats(std::size_t frameIndex) const {
+        const std::size_t slot = frameIndex % slotObjects.size();
+        if(slotObjects[slot] == 0) { return std::nullopt; }
+        const uint32_t visible = static_cast<const uint32_t *>(readbackAllocation.mapped)[slot];
+        return Stats{.visible = visible, .culled = slotObjects[slot] - visible};
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
@@ -0,0 +1,208 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#include "vkl/GpuScene.hpp"
+
+#include "vkl/UploadEngine.hpp"
+
+namespace lve {
+
+    GpuScene::GpuScene(Device &device) : lveDevice{device} {
+        // the object index travels in firstInstance, there is no other per draw input without extra features
+        if(!lveDevice.supportsDrawIndirectFirstInstance()) [[unlikely]] {
+            throw std::runtime_error("GpuScene needs the drawIndirectFirstInstance feature");
+        }
+        if(!lveDevice.supportsMultiDrawIndirect()) {
+            LWARN("multiDrawIndirect is not supported, GpuScene issues one indirect draw per object");
+        }
+        createDescriptors();
+    }
+
+    GpuScene::~GpuScene() {
+        destroyBuffers();
+        vkDestroyDescriptorPool(lveDevice.device(), descriptorPool, nullptr);
+        vkDestroyDescriptorSetLayout(lveDevice.device(), setLayout, nullptr);
+    }
+
+    void GpuScene::createDescriptors() {
+        const VkDescriptorSetLayoutBinding binding{.binding = OBJECT_BINDING,
+                                                   .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                                   .descriptorCount = 1,
+                                                   .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+                                                   .pImmutableSamplers = nullptr};
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = 1;
+        layoutInfo.pBindings = &binding;
+        VK_CHECK(vkCreateDescriptorSetLayout(lveDevice.device(), &layoutInfo, nullptr, &setLayout),
+                 "failed to create scene descriptor set layout!");
+
+        const VkDescriptorPoolSize poolSize{.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .descriptorCount = 1};
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets = 1;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+        VK_CHECK(vkCreateDescriptorPool(lveDevice.device(), &poolInfo, nullptr, &descriptorPool),
+                 "failed to create scene descriptor pool!");
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &setLayout;
+        VK_CHECK(vkAllocateDescriptorSets(lveDevice.device(), &allocInfo, &descriptorSet), "failed to allocate scene descriptor set!");
+    }
+
+    void GpuScene::destroyBuffers() {
+        for(auto [buffer, allocation] : {std::pair{&vertexBuffer, &vertexAllocation}, std::pair{&indexBuffer, &indexAllocation},
+                                         std::pair{&objectBuffer_, &objectAllocation}, std::pair{&meshBuffer_, &meshAllocation},
+                                         std::pair{&drawBuffer, &drawAllocation}, std::pair{&countBuffer, &countAllocation}}) {
+            if(*buffer != VK_NULL_HANDLE) { lveDevice.destroyBuffer(*buffer, *allocation); }
+        }
+        builtObjects = 0;
+    }
+
+    uint32_t GpuScene::addMesh(const MeshData &mesh) {
+        if(mesh.vertices.empty() || mesh.indices.empty()) [[unlikely]] {
+            throw std::invalid_argument("a scene mesh needs vertices and indices");
+        }
+        if(vertices.size() + mesh.vertices.size() > C_ST(std::numeric_limits<int32_t>::max())) [[unlikely]] {
+            throw std::length_error("scene vertex buffer exceeds the vertexOffset range");
+        }
+
+        meshes.emplace_back(MeshRange{.firstIndex = C_UI32T(indices.size()),
+                                      .indexCount = C_UI32T(mesh.indices.size()),
+                                      .vertexOffset = C_I32T(vertices.size()),
+                                      .vertexCount = C_UI32T(mesh.vertices.size()),
+                                      .bounds = Model::Bounds::of(mesh.vertices)});
+        // indices stay relative to the mesh, vertexOffset rebases them at draw time
+        vertices.insert(vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+        indices.insert(indices.end(), mesh.indices.begin(), mesh.indices.end());
+        return C_UI32T(meshes.size() - 1);
+    }
+
+    uint32_t GpuScene::addObject(const glm::mat4 &transform, uint32_t meshId, uint32_t materialId) {
+        if(meshId >= meshes.size()) [[unlikely]] { throw std::out_of_range(FORMAT("unknown mesh id {}", meshId)); }
+        objects.emplace_back(ObjectData{.transform = transform, .meshId = meshId, .materialId = materialId});
+        return C_UI32T(objects.size() - 1);
+    }
+
+    void GpuScene::build() {
+        if(objects.empty()) [[unlikely]] { throw std::invalid_argument("a scene needs at least one object"); }
+        destroyBuffers();
+
+        std::vector<VkDrawIndexedIndirectCommand> commands;
+        commands.reserve(objects.size());
+        for(uint32_t object = 0; object < C_UI32T(objects.size()); object++) {
+            const MeshRange &range = meshes[objects[object].meshId];
+            commands.emplace_back(VkDrawIndexedIndirectCommand{.indexCount = range.indexCount,
+                                                               .instanceCount = 1,
+                                                               .firstIndex = range.firstIndex,
+                                                               .vertexOffset = range.vertexOffset,
+                                                               .firstInstance = object});
+        }
+        const auto drawCount = C_UI32T(commands.size());
+
+        std::vector<MeshInfo> meshInfos;
+        meshInfos.reserve(meshes.size());
+        for(const MeshRange &range : meshes) {
+            meshInfos.emplace_back(MeshInfo{.sphere = glm::vec4{range.bounds.center, range.bounds.radius},
+                                            .boxMin = glm::vec4{range.bounds.min, 0.0f},
+                                            .boxMax = glm::vec4{range.bounds.max, 0.0f},
+                                            .firstIndex = range.firstIndex,
+                                            .indexCount = range.indexCount,
+                                            .vertexOffset = range.vertexOffset});
+        }
+
+        const std::array<std::span<const std::byte>, 6> sections{
+            std::as_bytes(std::span{vertices}),  std::as_bytes(std::span{indices}),  std::as_bytes(std::span{objects}),
+            std::as_bytes(std::span{meshInfos}), std::as_bytes(std::span{commands}), std::as_bytes(std::span{&drawCount, 1})};
+        VkDeviceSize stagingSize = 0;
+        for(const auto &section : sections) { stagingSize += section.size(); }
+
+        VkBuffer stagingBuffer{};
+        Allocation stagingAllocation{};
+        lveDevice.createBuffer(stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer,
+                               stagingAllocation);
+
+        // the draw commands and their count are storage buffers too, so that a compute pass can rewrite them and the
+        // results can be read back
+        const std::array<VkBufferUsageFlags, 6> usages{VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                                       VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                                                       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                                       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                                       VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                                           VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                                       VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                                           VK_BUFFER_USAGE_TRANSFER_SRC_BIT};
+        const std::array<std::pair<VkBuffer *, Allocation *>, 6> targets{
+            std::pair{&vertexBuffer, &vertexAllocation},  std::pair{&indexBuffer, &indexAllocation},
+            std::pair{&objectBuffer_, &objectAllocation}, std::pair{&meshBuffer_, &meshAllocation},
+            std::pair{&drawBuffer, &drawAllocation},      std::pair{&countBuffer, &countAllocation}};
+
+        auto &uploader = lveDevice.uploader();
+        auto batch = uploader.beginBatch();
+        auto *staging = static_cast<std::byte *>(stagingAllocation.mapped);
+        VkDeviceSize offset = 0;
+        for(std::size_t section = 0; section < sections.size(); section++) {
+            const VkDeviceSize size = sections[section].size();
+            std::memcpy(staging + offset, sections[section].data(), C_ST(size));
+            auto [buffer, allocation] = targets[section];
+            lveDevice.createBuffer(size, usages[section] | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, *buffer,
+                                   *allocation);
+            batch.copyBuffer(stagingBuffer, *buffer, size, offset);
+            offset += size;
+        }
+        uploader.wait(uploader.flush(std::move(batch)));
+        lveDevice.destroyBuffer(stagingBuffer, stagingAllocation);
+        builtObjects = drawCount;
+
+        const VkDescriptorBufferInfo objectInfo{.buffer = objectBuffer_, .offset = 0, .range = VK_WHOLE_SIZE};
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = descriptorSet;
+        write.dstBinding = OBJECT_BINDING;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        write.pBufferInfo = &objectInfo;
+        vkUpdateDescriptorSets(lveDevice.device(), 1, &write, 0, nullptr);
+
+        LINFO("GPU scene: {} meshes, {} objects, {} vertices, {} indices ({} KB)", meshes.size(), objects.size(), vertices.size(),
+              indices.size(), stagingSize / 1024);
+    }
+
+    void GpuScene::bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, const glm::mat4 &viewProjection) const {
+        const std::array<VkBuffer, 1> buffers{vertexBuffer};
+        const std::array<VkDeviceSize, 1> offsets{0};
+        vkCmdBindVertexBuffers(commandBuffer, 0, C_UI32T(buffers.size()), buffers.data(), offsets.data());
+        vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, CAMERA_PUSH_CONSTANTS.stageFlags, CAMERA_PUSH_CONSTANTS.offset,
+                           CAMERA_PUSH_CONSTANTS.size, &viewProjection);
+    }
+
+    bool GpuScene::drawsWithCount() const noexcept {
+        // the count is a maxDrawCount of up to every object, which needs multiDrawIndirect as well
+        return lveDevice.supportsDrawIndirectCount() && lveDevice.supportsMultiDrawIndirect();
+    }
+
+    void GpuScene::draw(VkCommandBuffer commandBuffer) const {
+        constexpr auto stride = C_UI32T(sizeof(VkDrawIndexedIndirectCommand));
+        const uint32_t maxDraws = lveDevice.supportsMultiDrawIndirect() ? lveDevice.properties.limits.maxDrawIndirectCount : 1;
+        if(drawsWithCount()) {
+            vkCmdDrawIndexedIndirectCount(commandBuffer, drawBuffer, 0, countBuffer, 0, std::min(maxDraws, builtObjects), stride);
+            return;
+        }
+        // without a count buffer every command is consumed, culling then has to zero instanceCount instead of compacting
+        for(uint32_t first = 0; first < builtObjects; first += maxDraws) {
+            const uint32_t count = std::min(maxDraws, builtObjects - first);
+            vkCmdDrawIndexedIndirect(commandBuffer, drawBuffer, VkDeviceSize{first} * stride, count, stride);
+        }
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
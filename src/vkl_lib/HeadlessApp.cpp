@@ -0,0 +1,119 @@
+// clang-format off
+// NOLINTBEGIN(*-include-cleaner, *-avoid-magic-numbers,*-magic-numbers, *-uppercase-literal-suffix,*-uppercase-literal-suffix,  *-pro-type-union-access)
+// clang-format on
+#include "vkl/HeadlessApp.hpp"
+
+#include "vkl/Window.hpp"
+
+namespace lve {
+
+    HeadlessApp::HeadlessApp() {
+        loadModels();
+        createPipelineLayout();
+        createPipeline();
+    }
+
+    HeadlessApp::~HeadlessApp() { vkDestroyPipelineLayout(lveDevice.device(), pipelineLayout, nullptr); }
+
+    void HeadlessApp::run(std::size_t frameCount) {
+        const vnd::Timer timer{"headless frames"};
+        for(std::size_t frame = 0; frame < frameCount; frame++) { drawFrame(); }
+        vkDeviceWaitIdle(lveDevice.device());
+
+        const long double elapsedNs = timer.make_time();
+        const long double fps = elapsedNs > 0 ? C_LD(frameCount) * 1'000'000'000.0L / elapsedNs : 0.0L;
+        LINFO("Headless: {} frames of {}x{} in {} ({:.1f} FPS, {} per frame)", frameCount, lveTarget.width(), lveTarget.height(),
+              vnd::Timer::make_time_str(elapsedNs), fps, vnd::Timer::make_time_str(frameCount > 0 ? elapsedNs / C_LD(frameCount) : 0.0L));
+    }
+
+    void HeadlessApp::loadModels() {
+        const std::array<Model::Vertex, 3> vertices{Model::Vertex{{0.0f, -0.5f, 0.0f}, {1.0f, 0.0f, 0.0f}},
+                                                    Model::Vertex{{0.5f, 0.5f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+                                                    Model::Vertex{{-0.5f, 0.5f, 0.0f}, {0.0f, 0.0f, 1.0f}}};
+        const std::array<uint32_t, 3> indices{0, 1, 2};
+        lveModel = MAKE_UNIQUE(Model, lveDevice, vertices, indices);
+    }
+
+    void HeadlessApp::createPipelineLayout() {
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 0;
+        pipelineLayoutInfo.pSetLayouts = nullptr;
+        pipelineLayoutInfo.pushConstantRangeCount = 0;
+        pipelineLayoutInfo.pPushConstantRanges = nullptr;
+        VK_CHECK(vkCreatePipelineLayout(lveDevice.device(), &pipelineLayoutInfo, nullptr, &pipelineLayout), "failed to create pipeline layout!");
+    }
+
+    void HeadlessApp::createPipeline() {
+        PipelineConfigInfo pipelineConfig{};
+        Pipeline::defaultPipelineConfigInfo(pipelineConfig);
+        pipelineConfig.renderPass = lveTarget.getRenderPass();
+        pipelineConfig.pipelineLayout = pipelineLayout;
+        lvePipeline = MAKE_UNIQUE(
+            Pipeline, lveDevice, Window::calculateRelativePathToSrcShaders(curentP, "simple_shader.vert.opt.rmp.spv").string(),
+            Window::calculateRelativePathToSrcShaders(curentP, "simple_shader.frag.opt.rmp.spv").string(), pipelineConfig);
+    }
+
+    void HeadlessApp::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        if(vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+            throw std::runtime_error("failed to begin recording command buffer!");
+        }
+
+        VkRenderPassBeginInfo renderPassInfo{};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassInfo.renderPass = lveTarget.getRenderPass();
+        renderPassInfo.framebuffer = lveTarget.getFrameBuffer(C_I(imageIndex));
+
+        renderPassInfo.renderArea.offset = {0, 0};
+        renderPassInfo.renderArea.extent = lveTarget.getSwapChainExtent();
+
+        std::array<VkClearValue, 2> clearValues{};
+        clearValues[0].color = VkClearColorValue{.float32{0.1f, 0.1f, 0.1f, 1.0f}};
+        clearValues[1].depthStencil = {.depth = 1.0f, .stencil = 0};
+        renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
+        renderPassInfo.pClearValues = clearValues.data();
+
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+        const VkExtent2D extent = lveTarget.getSwapChainExtent();
+        const VkViewport viewport{.x = 0.0f,
+                                  .y = 0.0f,
+                                  .width = static_cast<float>(extent.width),
+                                  .height = static_cast<float>(extent.height),
+                                  .minDepth = 0.0f,
+                                  .maxDepth = 1.0f};
+        const VkRect2D scissor{.offset = {0, 0}, .extent = extent};
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+        lvePipeline->bind(commandBuffer);
+        lveModel->bind(commandBuffer);
+        lveModel->draw(commandBuffer);
+
+        vkCmdEndRenderPass(commandBuffer);
+        if(vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) { throw std::runtime_error("failed to record command buffer!"); }
+    }
+
+    void HeadlessApp::drawFrame() {
+        uint32_t imageIndex;  // NOLINT(*-init-variables)
+        auto result = lveTarget.acquireNextImage(&imageIndex);
+        if(result != VK_SUCCESS) { throw std::runtime_error("failed to acquire offscreen image!"); }
+        const auto frameIndex = lveTarget.getCurrentFrame();
+        frameRing.beginFrame(frameIndex);
+        frameContext.beginFrame(frameIndex);
+        VkCommandBuffer commandBuffer = frameContext.commandBuffer();
+        recordCommandBuffer(commandBuffer, imageIndex);
+
+        result = lveTarget.submitCommandBuffers(&commandBuffer, &imageIndex);
+        if(result != VK_SUCCESS) { throw std::runtime_error("failed to submit offscreen frame!"); }
+    }
+
+}  // namespace lve
+
+// clang-format off
+// NOLINTEND(*-include-cleaner, *-avoid-magic-numbers,*-magic-numbers, *-uppercase-literal-suffix,*-uppercase-literal-suffix,  *-pro-type-union-access)
+// clang-format on
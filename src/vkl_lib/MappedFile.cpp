@@ -0,0 +1,115 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#include "vkl/MappedFile.hpp"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace lve {
+
+#ifdef _WIN32
+    MappedFile::MappedFile(const fs::path &path) : path_{path} {
+        HANDLE handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if(handle == INVALID_HANDLE_VALUE) [[unlikely]] { throw std::runtime_error(FORMAT("failed to open {}", path.string())); }
+        file = handle;
+
+        LARGE_INTEGER fileSize{};
+        if(!GetFileSizeEx(handle, &fileSize)) [[unlikely]] {
+            unmap();
+            throw std::runtime_error(FORMAT("failed to query the size of {}", path.string()));
+        }
+        size_ = C_ST(fileSize.QuadPart);
+        if(size_ == 0) { return; }
+
+        mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(mapping != nullptr) { data_ = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)); }
+        if(data_ == nullptr) [[unlikely]] {
+            unmap();
+            throw std::runtime_error(FORMAT("failed to map {}", path.string()));
+        }
+    }
+
+    void MappedFile::unmap() noexcept {
+        if(data_ != nullptr) { UnmapViewOfFile(data_); }
+        if(mapping != nullptr) { CloseHandle(mapping); }
+        if(file != nullptr) { CloseHandle(file); }
+        data_ = nullptr;
+        mapping = nullptr;
+        file = nullptr;
+        size_ = 0;
+    }
+#else
+    MappedFile::MappedFile(const fs::path &path) : path_{path} {
+        const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);  // NOLINT(*-vararg, *-signed-bitwise)
+        if(descriptor < 0) [[unlikely]] { throw std::runtime_error(FORMAT("failed to open {}", path.string())); }
+
+        struct stat status {};
+        if(::fstat(descriptor, &status) != 0) [[unlikely]] {
+            ::close(descriptor);
+            throw std::runtime_error(FORMAT("failed to query the size of {}", path.string()));
+        }
+        size_ = C_ST(status.st_size);
+        if(size_ > 0) {
+            void *mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if(mapped == MAP_FAILED) [[unlikely]] {  // NOLINT(*-cstyle-cast, *-int-to-ptr)
+                ::close(descriptor);
+                throw std::runtime_error(FORMAT("failed to map {}", path.string()));
+            }
+            // the whole file is about to be scanned, possibly by several threads at different offsets
+            ::madvise(mapped, size_, MADV_WILLNEED);
+            data_ = static_cast<const char *>(mapped);
+        }
+        // the mapping keeps its own reference to the file
+        ::close(descriptor);
+    }
+
+    void MappedFile::unmap() noexcept {
+        if(data_ != nullptr) { ::munmap(const_cast<char *>(data_), size_); }  // NOLINT(*-const-cast)
+        data_ = nullptr;
+        size_ = 0;
+    }
+#endif
+
+    MappedFile::~MappedFile() { unmap(); }
+
+    MappedFile::MappedFile(MappedFile &&other) noexcept
+      : path_{std::move(other.path_)}, data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)}
+#ifdef _WIN32
+        ,
+        file{std::exchange(other.file, nullptr)}, mapping{std::exchange(other.mapping, nullptr)}
+#endif
+    {
+    }
+
+    MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+        if(this != &other) {
+            unmap();
+            path_ = std::move(other.path_);
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+            file = std::exchange(other.file, nullptr);
+            mapping = std::exchange(other.mapping, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
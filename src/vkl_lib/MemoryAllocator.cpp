@@ -0,0 +1,230 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner, *-signed-bitwise)
+#include "vkl/MemoryAllocator.hpp"
+
+#include <bit>
+
+namespace lve {
+
+    MemoryAllocator::MemoryAllocator(VkPhysicalDevice physicalDevice, VkDevice device, VkDeviceSize bufferImageGranularity,
+                                     VkDeviceSize preferredBlockSize)
+      : device_{device}, preferredBlockSize_{std::bit_floor(preferredBlockSize)},
+        separateResourceKinds{bufferImageGranularity > MIN_ALLOCATION_SIZE} {
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+        pools.resize(C_ST(memProperties.memoryTypeCount) * 2);
+        for(uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+            const VkDeviceSize heapSize = memProperties.memoryHeaps[memProperties.memoryTypes[i].heapIndex].size;
+            // small heaps (e.g. the 256MiB BAR window) get smaller blocks so a single block never eats the whole heap
+            const VkDeviceSize minBlockSize = std::min(MIN_ALLOCATION_SIZE << 12, preferredBlockSize_);
+            const VkDeviceSize blockSize = std::clamp(std::bit_floor(heapSize / 8), minBlockSize, preferredBlockSize_);
+            for(uint32_t kind = 0; kind < 2; kind++) {
+                Pool &pool = pools[C_ST(i) * 2 + kind];
+                pool.memoryTypeIndex = i;
+                pool.blockSize = blockSize;
+                pool.maxOrder = orderFor(blockSize);
+            }
+        }
+        LINFO("Memory allocator: {} memory types, bufferImageGranularity {}, {} linear/optimal blocks", memProperties.memoryTypeCount,
+              bufferImageGranularity, separateResourceKinds ? "separate" : "shared");
+    }
+
+    MemoryAllocator::~MemoryAllocator() {
+        logStats();
+        for(auto &pool : pools) {
+            for(auto &block : pool.blocks) {
+                if(block.memory == VK_NULL_HANDLE) { continue; }
+                if(block.allocationCount != 0) [[unlikely]] {
+                    LWARN("Memory block of type {} destroyed with {} live allocations", pool.memoryTypeIndex, block.allocationCount);
+                }
+                vkFreeMemory(device_, block.memory, nullptr);
+            }
+        }
+        if(dedicatedCount != 0) [[unlikely]] { LWARN("{} dedicated allocations leaked", dedicatedCount); }
+    }
+
+    uint32_t MemoryAllocator::orderFor(VkDeviceSize size) noexcept {
+        const VkDeviceSize rounded = std::bit_ceil(std::max(size, MIN_ALLOCATION_SIZE));
+        return C_UI32T(std::countr_zero(rounded) - std::countr_zero(MIN_ALLOCATION_SIZE));
+    }
+
+    bool MemoryAllocator::isHostCoherent(uint32_t memoryTypeIndex) const noexcept {
+        constexpr VkMemoryPropertyFlags coherent = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        return (memProperties.memoryTypes[memoryTypeIndex].propertyFlags & coherent) == coherent;
+    }
+
+    std::optional<uint32_t> MemoryAllocator::tryFindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const noexcept {
+        const std::bitset<32> typeBits(typeFilter);
+        for(uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+            if(typeBits.test(i) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) { return i; }
+        }
+        return std::nullopt;
+    }
+
+    uint32_t MemoryAllocator::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const {
+        if(const auto index = tryFindMemoryType(typeFilter, properties); index.has_value()) { return *index; }
+        throw std::runtime_error("failed to find suitable memory type!");
+    }
+
+    VkDeviceMemory MemoryAllocator::allocateMemory(VkDeviceSize size, uint32_t memoryTypeIndex, void **mapped) {
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = size;
+        allocInfo.memoryTypeIndex = memoryTypeIndex;
+
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VK_CHECK(vkAllocateMemory(device_, &allocInfo, nullptr, &memory), "failed to allocate device memory block!");
+
+        *mapped = nullptr;
+        if(isHostCoherent(memoryTypeIndex)) {
+            VK_CHECK(vkMapMemory(device_, memory, 0, VK_WHOLE_SIZE, 0, mapped), "failed to map device memory block!");
+        }
+        return memory;
+    }
+
+    Allocation MemoryAllocator::allocateDedicated(VkDeviceSize size, uint32_t memoryTypeIndex) {
+        Allocation allocation{};
+        allocation.memory = allocateMemory(size, memoryTypeIndex, &allocation.mapped);
+        allocation.size = size;
+        dedicatedCount++;
+        dedicatedBytes += size;
+        return allocation;
+    }
+
+    MemoryAllocator::Block &MemoryAllocator::createBlock(Pool &pool) {
+        auto slot = std::ranges::find_if(pool.blocks, [](const Block &block) { return block.memory == VK_NULL_HANDLE; });
+        if(slot == pool.blocks.end()) { slot = pool.blocks.emplace(pool.blocks.end()); }
+
+        Block &block = *slot;
+        block.memory = allocateMemory(pool.blockSize, pool.memoryTypeIndex, &block.mapped);
+        block.freeLists.assign(C_ST(pool.maxOrder) + 1, {});
+        block.freeLists[pool.maxOrder].insert(0);
+        block.allocationCount = 0;
+        block.usedBytes = 0;
+        return block;
+    }
+
+    std::optional<VkDeviceSize> MemoryAllocator::allocateFromBlock(Block &block, uint32_t order, uint32_t maxOrder) {
+        uint32_t current = order;
+        while(current <= maxOrder && block.freeLists[current].empty()) { current++; }
+        if(current > maxOrder) { return std::nullopt; }
+
+        auto &freeList = block.freeLists[current];
+        const VkDeviceSize offset = *freeList.begin();
+        freeList.erase(freeList.begin());
+        // split down to the requested order, returning the upper halves to the free lists
+        while(current > order) {
+            current--;
+            block.freeLists[current].insert(offset + orderSize(current));
+        }
+        block.allocationCount++;
+        block.usedBytes += orderSize(order);
+        return offset;
+    }
+
+    void MemoryAllocator::freeToBlock(Block &block, VkDeviceSize offset, uint32_t order, uint32_t maxOrder) {
+        block.allocationCount--;
+        block.usedBytes -= orderSize(order);
+        // merge with the buddy for as long as it is free
+        while(order < maxOrder) {
+            const VkDeviceSize buddy = offset ^ orderSize(order);
+            auto &freeList = block.freeLists[order];
+            const auto it = freeList.find(buddy);
+            if(it == freeList.end()) { break; }
+            freeList.erase(it);
+            offset = std::min(offset, buddy);
+            order++;
+        }
+        block.freeLists[order].insert(offset);
+    }
+
+    Allocation MemoryAllocator::allocate(const VkMemoryRequirements &requirements, VkMemoryPropertyFlags properties, ResourceKind kind,
+                                         VkMemoryPropertyFlags preferred) {
+        // mappings are handed out without flush or invalidate, the spec guarantees a coherent type for every host visible one
+        if(properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) { properties |= VK_MEMORY_PROPERTY_HOST_COHERENT_BIT; }
+        const auto preferredIndex = tryFindMemoryType(requirements.memoryTypeBits, properties | preferred);
+        const uint32_t memoryTypeIndex =
+            preferredIndex.has_value() ? *preferredIndex : findMemoryType(requirements.memoryTypeBits, properties);
+        // buddy ranges are aligned to their own size, so rounding up to the alignment is all that is needed
+        const VkDeviceSize size = std::max(requirements.size, requirements.alignment);
+
+        const std::scoped_lock lock{mutex};
+        const uint32_t poolIndex = memoryTypeIndex * 2 + (separateResourceKinds ? C_UI32T(kind) : 0);
+        Pool &pool = pools[poolIndex];
+        if(size > pool.blockSize / 2) { return allocateDedicated(requirements.size, memoryTypeIndex); }
+
+        const uint32_t order = orderFor(size);
+        for(auto &&[index, block] : std::views::enumerate(pool.blocks)) {
+            if(block.memory == VK_NULL_HANDLE) { continue; }
+            if(const auto offset = allocateFromBlock(block, order, pool.maxOrder); offset.has_value()) {
+                return Allocation{.memory = block.memory,
+                                  .offset = *offset,
+                                  .size = requirements.size,
+                                  .mapped = block.mapped != nullptr ? static_cast<std::byte *>(block.mapped) + *offset : nullptr,
+                                  .pool = poolIndex,
+                                  .block = C_UI32T(index),
+                                  .order = order};
+            }
+        }
+
+        Block &block = createBlock(pool);
+        const auto blockIndex = C_UI32T(std::distance(pool.blocks.data(), &block));
+        const VkDeviceSize offset = allocateFromBlock(block, order, pool.maxOrder).value();
+        return Allocation{.memory = block.memory,
+                          .offset = offset,
+                          .size = requirements.size,
+                          .mapped = block.mapped != nullptr ? static_cast<std::byte *>(block.mapped) + offset : nullptr,
+                          .pool = poolIndex,
+                          .block = blockIndex,
+                          .order = order};
+    }
+
+    void MemoryAllocator::free(Allocation &allocation) {
+        if(!allocation.isValid()) { return; }
+
+        const std::scoped_lock lock{mutex};
+        if(allocation.isDedicated()) {
+            vkFreeMemory(device_, allocation.memory, nullptr);
+            dedicatedCount--;
+            dedicatedBytes -= allocation.size;
+        } else {
+            Pool &pool = pools[allocation.pool];
+            Block &block = pool.blocks[allocation.block];
+            freeToBlock(block, allocation.offset, allocation.order, pool.maxOrder);
+
+            // keep one block per pool around so that allocate/free churn does not thrash vkAllocateMemory
+            const auto liveBlocks = std::ranges::count_if(pool.blocks, [](const Block &b) { return b.memory != VK_NULL_HANDLE; });
+            if(block.allocationCount == 0 && liveBlocks > 1) {
+                vkFreeMemory(device_, block.memory, nullptr);
+                block = Block{};
+            }
+        }
+        allocation = Allocation{};
+    }
+
+    AllocatorStats MemoryAllocator::stats() const {
+        const std::scoped_lock lock{mutex};
+        AllocatorStats result{.dedicatedCount = dedicatedCount, .allocationCount = dedicatedCount, .reservedBytes = dedicatedBytes,
+                              .usedBytes = dedicatedBytes};
+        for(const auto &pool : pools) {
+            for(const auto &block : pool.blocks) {
+                if(block.memory == VK_NULL_HANDLE) { continue; }
+                result.blockCount++;
+                result.allocationCount += block.allocationCount;
+                result.reservedBytes += pool.blockSize;
+                result.usedBytes += block.usedBytes;
+            }
+        }
+        return result;
+    }
+
+    void MemoryAllocator::logStats() const {
+        const auto [blockCount, dedicated, allocationCount, reservedBytes, usedBytes] = stats();
+        LINFO("Memory allocator: {} allocations in {} blocks + {} dedicated, {} / {} bytes used", allocationCount, blockCount, dedicated,
+              usedBytes, reservedBytes);
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner, *-signed-bitwise)
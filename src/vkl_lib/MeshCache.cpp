@@ -0,0 +1,195 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner, *-reinterpret-cast, *-pointer-arithmetic)
+#include "vkl/MeshCache.hpp"
+
+#include "vkl/MappedFile.hpp"
+#include "vkl/MeshOptimizer.hpp"
+#include "vkl/ObjLoader.hpp"
+#include "vkl/timer/Timer.hpp"
+
+namespace lve {
+
+    static constexpr uint64_t alignUp(uint64_t value, uint64_t alignment) noexcept {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    MeshCache::MeshCache(fs::path directory) : directory_{std::move(directory)} {}
+
+    fs::path MeshCache::defaultDirectory() {
+        // NOLINTNEXTLINE(*-mt-unsafe)
+        if(const char *env = std::getenv("VKL_MESH_CACHE"); env != nullptr) { return env; }
+        return curentP / "vkl_mesh_cache";
+    }
+
+    fs::path MeshCache::cachePathOf(const fs::path &source, VertexFormat format) const {
+        const std::string key = fs::weakly_canonical(source).generic_string();
+        const std::string_view suffix = format == VertexFormat::Quantized ? "-q" : "";
+        return directory_ / FORMAT("{}-{:016x}{}.vklmesh", source.stem().string(), fnv1a(key), suffix);
+    }
+
+    template <typename Vertex> MeshCache::FileHeader MeshCache::layoutHeaderOf() {
+        using Layout = VertexLayout<Vertex>;
+        static_assert(Layout::attributes.size() <= MAX_ATTRIBUTES, "the mesh cache header has no room for that many attributes");
+        FileHeader header{};
+        header.vertexStride = Layout::stride;
+        header.attributeCount = C_UI32T(Layout::attributes.size());
+        std::ranges::transform(Layout::attributes, header.attributes.begin(), [](const VkVertexInputAttributeDescription &attribute) {
+            return VertexAttribute{attribute.location, static_cast<uint32_t>(attribute.format), attribute.offset};
+        });
+        return header;
+    }
+
+    MeshCache::FileHeader MeshCache::layoutHeader(VertexFormat format) {
+        return format == VertexFormat::Quantized ? layoutHeaderOf<Model::QuantizedVertex>() : layoutHeaderOf<Model::Vertex>();
+    }
+
+    MeshCache::SourceStamp MeshCache::stampOf(const fs::path &source) {
+        return {fs::file_size(source), static_cast<int64_t>(fs::last_write_time(source).time_since_epoch().count())};
+    }
+
+    std::unique_ptr<Model> MeshCache::loadObj(Device &device, const fs::path &source, ThreadPool &pool, VertexFormat format) const {
+        const vnd::Timer timer{"mesh cache"};
+        const fs::path cachePath = cachePathOf(source, format);
+        if(auto model = tryLoad(device, cachePath, source, format)) {
+            LINFO("Mesh cache hit for {}: {} vertices, {} indices in {}", source.string(), model->vertexCount(), model->indexCount(),
+                  vnd::Timer::make_time_str(timer.make_time()));
+            return model;
+        }
+
+        FileHeader header = layoutHeader(format);
+        header.source = stampOf(source);
+        const MappedFile file{source};
+        header.sourceHash = fnv1a(file.view());
+        MeshData mesh = ObjLoader::parse(file.view(), pool, source.string());
+        MeshOptimizer::optimize(mesh);
+        header.bounds = Model::Bounds::of(mesh.vertices);
+        std::unique_ptr<Model> model;
+        std::vector<Model::QuantizedVertex> quantized;
+        std::span<const std::byte> vertexData = std::as_bytes(std::span{mesh.vertices});
+        if(format == VertexFormat::Quantized) {
+            quantized = Model::quantizeVertices(mesh.vertices);
+            vertexData = std::as_bytes(std::span{quantized});
+            model = MAKE_UNIQUE(Model, device, quantized, mesh.indices, header.bounds);
+        } else {
+            model = MAKE_UNIQUE(Model, device, mesh);
+        }
+        try {
+            write(cachePath, header, vertexData, mesh.indices);
+        } catch(const std::exception &e) { LWARN("Mesh cache not written for {}: {}", source.string(), e.what()); }
+        return model;
+    }
+
+    std::unique_ptr<Model> MeshCache::tryLoad(Device &device, const fs::path &cachePath, const fs::path &source,
+                                              VertexFormat format) const {
+        std::error_code error;
+        if(!fs::is_regular_file(cachePath, error)) { return nullptr; }
+
+        MappedFile file{cachePath};
+        if(file.size() < sizeof(FileHeader)) {
+            LWARN("Mesh cache {} is truncated, rebuilding it", cachePath.string());
+            return nullptr;
+        }
+        FileHeader header{};
+        std::memcpy(&header, file.data(), sizeof(header));
+
+        const FileHeader expected = layoutHeader(format);
+        if(header.magic != expected.magic || header.version != expected.version) {
+            LINFO("Mesh cache {} has another format version, rebuilding it", cachePath.string());
+            return nullptr;
+        }
+        if(header.vertexStride != expected.vertexStride || header.attributeCount != expected.attributeCount ||
+           header.attributes != expected.attributes) {
+            LINFO("Mesh cache {} was written with another vertex layout, rebuilding it", cachePath.string());
+            return nullptr;
+        }
+
+        const SourceStamp stamp = stampOf(source);
+        if(header.source.size != stamp.size) {
+            LINFO("Mesh cache {} is stale, rebuilding it", cachePath.string());
+            return nullptr;
+        }
+        const bool touched = header.source.mtime != stamp.mtime;
+        if(touched) {
+            // copies and checkouts touch the mtime without changing the content, only then is the source read
+            if(fnv1a(MappedFile{source}.view()) != header.sourceHash) {
+                LINFO("Mesh cache {} is stale, rebuilding it", cachePath.string());
+                return nullptr;
+            }
+            LINFO("Mesh cache {}: source mtime changed but its content did not", cachePath.string());
+        }
+
+        const auto indexType = static_cast<VkIndexType>(header.indexType);
+        const uint64_t vertexBytes = uint64_t{header.vertexCount} * header.vertexStride;
+        const uint64_t indexBytes = uint64_t{header.indexCount} * Model::indexSize(indexType);
+        const auto fits = [size = file.size()](uint64_t offset, uint64_t bytes) {
+            return offset % BLOB_ALIGNMENT == 0 && offset <= size && bytes <= size - offset;
+        };
+        if(header.vertexCount == 0 || (indexType != VK_INDEX_TYPE_UINT16 && indexType != VK_INDEX_TYPE_UINT32) ||
+           !fits(header.vertexOffset, vertexBytes) || !fits(header.indexOffset, indexBytes)) [[unlikely]] {
+            LWARN("Mesh cache {} is corrupt, rebuilding it", cachePath.string());
+            return nullptr;
+        }
+
+        // the blobs go from the mapping straight into the staging buffer
+        auto model = MAKE_UNIQUE(Model, device, file.bytes().subspan(C_ST(header.vertexOffset), C_ST(vertexBytes)), header.vertexStride,
+                                 file.bytes().subspan(C_ST(header.indexOffset), C_ST(indexBytes)), indexType, header.bounds);
+        if(touched) {
+            // the mapping keeps the file locked on Windows, it is released before the header is rewritten
+            { const MappedFile released{std::move(file)}; }
+            header.source = stamp;
+            restamp(cachePath, header);
+        }
+        return model;
+    }
+
+    void MeshCache::restamp(const fs::path &cachePath, const FileHeader &header) {
+        // only the header changes, so it is rewritten in place; a torn write fails the checks of the next load and rebuilds
+        std::fstream file{cachePath, std::ios::binary | std::ios::in | std::ios::out};  // NOLINT(*-signed-bitwise)
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        if(!file) [[unlikely]] {
+            LWARN("Mesh cache {}: new source mtime not written, the source will be hashed again", cachePath.string());
+        }
+    }
+
+    void MeshCache::write(const fs::path &cachePath, const FileHeader &header, std::span<const std::byte> vertexData,
+                          std::span<const uint32_t> indices) const {
+        FileHeader out = header;
+        out.vertexCount = C_UI32T(vertexData.size() / header.vertexStride);
+        out.indexCount = C_UI32T(indices.size());
+        const VkIndexType indexType = Model::indexTypeFor(out.vertexCount);
+        out.indexType = static_cast<uint32_t>(indexType);
+        out.vertexOffset = alignUp(sizeof(FileHeader), BLOB_ALIGNMENT);
+        out.indexOffset = alignUp(out.vertexOffset + vertexData.size(), BLOB_ALIGNMENT);
+
+        // indices are stored already packed, so a hit never has to convert them
+        std::vector<uint16_t> shortIndices;
+        std::span<const char> indexData{reinterpret_cast<const char *>(indices.data()), indices.size_bytes()};
+        if(indexType == VK_INDEX_TYPE_UINT16) {
+            shortIndices.resize(indices.size());
+            std::ranges::transform(indices, shortIndices.begin(), [](uint32_t index) { return static_cast<uint16_t>(index); });
+            indexData = {reinterpret_cast<const char *>(shortIndices.data()), std::span{shortIndices}.size_bytes()};
+        }
+
+        fs::create_directories(directory_);
+        fs::path tmpPath = cachePath;
+        tmpPath += ".tmp";
+        {
+            std::ofstream file{tmpPath, std::ios::binary | std::ios::trunc};  // NOLINT(*-signed-bitwise)
+            if(!file.is_open()) [[unlikely]] { throw std::runtime_error(FORMAT("failed to open {}", tmpPath.string())); }
+            constexpr std::array<char, BLOB_ALIGNMENT> padding{};
+            file.write(reinterpret_cast<const char *>(&out), sizeof(out));
+            file.write(padding.data(), C_LL(out.vertexOffset - sizeof(out)));
+            file.write(reinterpret_cast<const char *>(vertexData.data()), C_LL(vertexData.size()));
+            file.write(padding.data(), C_LL(out.indexOffset - out.vertexOffset - vertexData.size()));
+            file.write(indexData.data(), C_LL(indexData.size()));
+            if(!file) [[unlikely]] { throw std::runtime_error(FORMAT("failed to write {}", tmpPath.string())); }
+        }
+        fs::rename(tmpPath, cachePath);
+        LINFO("Mesh cache written: {} ({} bytes)", cachePath.string(), out.indexOffset + indexData.size());
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner, *-reinterpret-cast, *-pointer-arithmetic)
@@ -0,0 +1,298 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers)
+#include "vkl/MeshOptimizer.hpp"
+
+#include "vkl/timer/Timer.hpp"
+
+namespace lve {
+
+    namespace {
+        /// FIFO cache simulated with insertion timestamps, an entry is resident while fewer than size misses followed it.
+        class FifoCache {
+        public:
+            FifoCache(std::size_t entries, uint32_t cacheSize) : stamps(entries, 0), size{cacheSize}, time{cacheSize + 1} {}
+
+            /// Returns true on a miss, which inserts entry.
+            bool access(std::size_t entry) noexcept {
+                if(time - stamps[entry] <= size) { return false; }
+                stamps[entry] = time++;
+                return true;
+            }
+
+            void reset() noexcept { time += size + 1; }
+
+        private:
+            std::vector<uint32_t> stamps;
+            uint32_t size;
+            uint32_t time;
+        };
+
+        // Forsyth's scoring constants, from "Linear-Speed Vertex Cache Optimisation"
+        constexpr float cacheDecayPower = 1.5f;
+        constexpr float lastTriangleScore = 0.75f;
+        constexpr float valenceBoostScale = 2.0f;
+        constexpr float valenceBoostPower = 0.5f;
+        constexpr uint32_t maxScoredValence = 64;
+
+        struct ScoreTables {
+            std::array<float, MeshOptimizer::VERTEX_CACHE_SIZE> cache{};
+            std::array<float, maxScoredValence> valence{};
+
+            ScoreTables() {
+                constexpr auto cacheSize = MeshOptimizer::VERTEX_CACHE_SIZE;
+                for(uint32_t position = 0; position < cacheSize; position++) {
+                    // the last triangle's vertices get a fixed score so that it is not simply continued as a strip
+                    cache[position] = position < 3 ? lastTriangleScore
+                                                   : std::pow(1.0f - C_F(position - 3) / C_F(cacheSize - 3), cacheDecayPower);
+                }
+                for(uint32_t count = 1; count < maxScoredValence; count++) {
+                    valence[count] = valenceBoostScale * std::pow(C_F(count), -valenceBoostPower);
+                }
+            }
+
+            [[nodiscard]] float score(int32_t cachePosition, uint32_t activeTriangles) const noexcept {
+                if(activeTriangles == 0) { return -1.0f; }
+                const float valenceScore = valence[std::min(activeTriangles, maxScoredValence - 1)];
+                return cachePosition < 0 ? valenceScore : cache[C_ST(cachePosition)] + valenceScore;
+            }
+        };
+    }  // namespace
+
+    MeshOptimizer::Stats MeshOptimizer::analyze(std::span<const uint32_t> indices, std::size_t vertexCount, uint32_t cacheSize) {
+        Stats stats{};
+        if(indices.empty()) { return stats; }
+
+        constexpr std::size_t lineSize = 64;
+        constexpr uint32_t cachedLines = 256;  // a 16 KB vertex fetch cache
+        constexpr std::size_t stride = sizeof(Model::Vertex);
+        FifoCache vertexCache{vertexCount, cacheSize};
+        FifoCache lineCache{(vertexCount * stride + lineSize - 1) / lineSize, cachedLines};
+        std::vector<bool> referenced(vertexCount, false);
+        std::size_t transformed = 0;
+        std::size_t unique = 0;
+        std::size_t fetchedLines = 0;
+        for(const uint32_t index : indices) {
+            if(!vertexCache.access(index)) { continue; }
+            transformed++;
+            if(!referenced[index]) {
+                referenced[index] = true;
+                unique++;
+            }
+            for(std::size_t line = index * stride / lineSize; line <= (index * stride + stride - 1) / lineSize; line++) {
+                fetchedLines += lineCache.access(line) ? 1 : 0;
+            }
+        }
+
+        stats.acmr = C_F(transformed) / C_F(indices.size() / 3);
+        stats.atvr = C_F(transformed) / C_F(unique);
+        stats.overfetch = C_F(fetchedLines * lineSize) / C_F(unique * stride);
+        return stats;
+    }
+
+    void MeshOptimizer::optimizeVertexCache(std::span<uint32_t> indices, std::size_t vertexCount) {
+        const std::size_t triangleCount = indices.size() / 3;
+        if(triangleCount == 0) { return; }
+        if(std::ranges::any_of(indices, [vertexCount](uint32_t index) { return index >= vertexCount; })) [[unlikely]] {
+            throw std::invalid_argument("mesh index out of the vertex range");
+        }
+
+        // triangles using each vertex, the first activeTriangles[vertex] of them are still to be emitted
+        std::vector<uint32_t> activeTriangles(vertexCount, 0);
+        for(const uint32_t index : indices) { activeTriangles[index]++; }
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        std::inclusive_scan(activeTriangles.begin(), activeTriangles.end(), adjacencyOffsets.begin() + 1);
+        std::vector<uint32_t> adjacency(indices.size());
+        {
+            std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for(std::size_t corner = 0; corner < indices.size(); corner++) { adjacency[fill[indices[corner]]++] = C_UI32T(corner / 3); }
+        }
+
+        const ScoreTables tables{};
+        std::vector<int32_t> cachePositions(vertexCount, -1);
+        std::vector<float> scores(vertexCount);
+        for(std::size_t vertex = 0; vertex < vertexCount; vertex++) { scores[vertex] = tables.score(-1, activeTriangles[vertex]); }
+
+        std::vector<uint32_t> ordered(indices.size());
+        std::vector<bool> emitted(triangleCount, false);
+        std::array<uint32_t, VERTEX_CACHE_SIZE + 3> cache{};
+        std::array<uint32_t, VERTEX_CACHE_SIZE + 3> nextCache{};
+        std::size_t cacheCount = 0;
+        std::size_t fallback = 0;
+        int64_t best = -1;
+        for(std::size_t output = 0; output < triangleCount; output++) {
+            if(best < 0) {
+                // dead end: nothing left around the cache, restart from the first triangle not emitted yet
+                while(emitted[fallback]) { fallback++; }
+                best = C_LL(fallback);
+            }
+            const auto triangle = C_ST(best);
+            emitted[triangle] = true;
+            const std::span<const uint32_t, 3> corners{indices.subspan(triangle * 3).first<3>()};
+            std::ranges::copy(corners, ordered.begin() + C_LL(output * 3));
+
+            std::size_t nextCount = 0;
+            for(const uint32_t vertex : corners) {
+                auto *const first = adjacency.data() + adjacencyOffsets[vertex];
+                auto *const last = first + activeTriangles[vertex];
+                if(auto *const found = std::find(first, last, C_UI32T(triangle)); found != last) {
+                    std::iter_swap(found, last - 1);
+                    activeTriangles[vertex]--;
+                }
+                if(std::find(nextCache.begin(), nextCache.begin() + C_LL(nextCount), vertex) == nextCache.begin() + C_LL(nextCount)) {
+                    nextCache[nextCount++] = vertex;
+                }
+            }
+            for(std::size_t slot = 0; slot < cacheCount; slot++) {
+                if(std::ranges::find(corners, cache[slot]) == corners.end()) { nextCache[nextCount++] = cache[slot]; }
+            }
+
+            // rescore the cached vertices, including the ones just pushed out, and pick the best triangle around them
+            for(std::size_t slot = 0; slot < nextCount; slot++) {
+                const uint32_t vertex = nextCache[slot];
+                cachePositions[vertex] = slot < VERTEX_CACHE_SIZE ? C_I(slot) : -1;
+                scores[vertex] = tables.score(cachePositions[vertex], activeTriangles[vertex]);
+            }
+            best = -1;
+            float bestScore = -1.0f;
+            for(std::size_t slot = 0; slot < nextCount; slot++) {
+                const uint32_t vertex = nextCache[slot];
+                for(uint32_t edge = 0; edge < activeTriangles[vertex]; edge++) {
+                    const uint32_t candidate = adjacency[adjacencyOffsets[vertex] + edge];
+                    const float score =
+                        scores[indices[candidate * 3]] + scores[indices[candidate * 3 + 1]] + scores[indices[candidate * 3 + 2]];
+                    if(score > bestScore) {
+                        bestScore = score;
+                        best = candidate;
+                    }
+                }
+            }
+
+            cacheCount = std::min(nextCount, std::size_t{VERTEX_CACHE_SIZE});
+            std::copy_n(nextCache.begin(), cacheCount, cache.begin());
+        }
+        std::ranges::copy(ordered, indices.begin());
+    }
+
+    void MeshOptimizer::optimizeOverdraw(std::span<uint32_t> indices, std::span<const Model::Vertex> vertices, float threshold) {
+        const std::size_t triangleCount = indices.size() / 3;
+        if(triangleCount < 2) { return; }
+
+        // hard boundaries: triangles whose three vertices all miss, the cache starts over there anyway
+        FifoCache cache{vertices.size(), FIFO_CACHE_SIZE};
+        const auto triangleMisses = [&](std::size_t triangle) {
+            uint32_t misses = 0;
+            for(std::size_t corner = 0; corner < 3; corner++) { misses += cache.access(indices[triangle * 3 + corner]) ? 1 : 0; }
+            return misses;
+        };
+        std::vector<std::size_t> hardBoundaries{0};
+        for(std::size_t triangle = 0; triangle < triangleCount; triangle++) {
+            // every triangle goes through the cache, the first one already starts a cluster
+            if(triangleMisses(triangle) == 3 && triangle != 0) { hardBoundaries.push_back(triangle); }
+        }
+        hardBoundaries.push_back(triangleCount);
+
+        // soft boundaries: inside a hard cluster, cut as soon as the running ACMR is within threshold of the cluster's
+        std::vector<std::size_t> clusters;
+        for(std::size_t hard = 0; hard + 1 < hardBoundaries.size(); hard++) {
+            const std::size_t begin = hardBoundaries[hard];
+            const std::size_t end = hardBoundaries[hard + 1];
+            cache.reset();
+            std::size_t clusterMisses = 0;
+            for(std::size_t triangle = begin; triangle < end; triangle++) { clusterMisses += triangleMisses(triangle); }
+            const float target = C_F(clusterMisses) / C_F(end - begin) * threshold;
+
+            cache.reset();
+            clusters.push_back(begin);
+            std::size_t misses = 0;
+            std::size_t start = begin;
+            for(std::size_t triangle = begin; triangle + 1 < end; triangle++) {
+                misses += triangleMisses(triangle);
+                if(C_F(misses) / C_F(triangle + 1 - start) <= target) {
+                    clusters.push_back(triangle + 1);
+                    cache.reset();
+                    misses = 0;
+                    start = triangle + 1;
+                }
+            }
+        }
+        clusters.push_back(triangleCount);
+
+        // sort key: how much the cluster faces away from the mesh centroid, outer shells occlude the rest
+        struct Cluster {
+            std::size_t begin;
+            std::size_t end;
+            glm::vec3 centroid{};
+            glm::vec3 normal{};
+            float area = 0.0f;
+            float key = 0.0f;
+        };
+        std::vector<Cluster> sorted;
+        sorted.reserve(clusters.size() - 1);
+        glm::vec3 meshCentroid{};
+        float meshArea = 0.0f;
+        for(std::size_t cluster = 0; cluster + 1 < clusters.size(); cluster++) {
+            Cluster &current = sorted.emplace_back(Cluster{clusters[cluster], clusters[cluster + 1]});
+            for(std::size_t triangle = current.begin; triangle < current.end; triangle++) {
+                const glm::vec3 &a = vertices[indices[triangle * 3]].position;
+                const glm::vec3 &b = vertices[indices[triangle * 3 + 1]].position;
+                const glm::vec3 &c = vertices[indices[triangle * 3 + 2]].position;
+                const glm::vec3 normal = glm::cross(b - a, c - a);
+                const float area = glm::length(normal);
+                current.centroid += (a + b + c) * (area / 3.0f);
+                current.normal += normal;
+                current.area += area;
+            }
+            meshCentroid += current.centroid;
+            meshArea += current.area;
+            if(current.area > 0.0f) { current.centroid /= current.area; }
+        }
+        if(meshArea > 0.0f) { meshCentroid /= meshArea; }
+        for(Cluster &cluster : sorted) {
+            const float length = glm::length(cluster.normal);
+            cluster.key = length > 0.0f ? glm::dot(cluster.centroid - meshCentroid, cluster.normal / length) : 0.0f;
+        }
+        std::ranges::stable_sort(sorted, std::ranges::greater{}, &Cluster::key);
+
+        std::vector<uint32_t> ordered;
+        ordered.reserve(indices.size());
+        for(const Cluster &cluster : sorted) {
+            ordered.insert(ordered.end(), indices.begin() + C_LL(cluster.begin * 3), indices.begin() + C_LL(cluster.end * 3));
+        }
+        std::ranges::copy(ordered, indices.begin());
+    }
+
+    void MeshOptimizer::optimizeVertexFetch(MeshData &mesh) {
+        if(mesh.indices.empty()) { return; }
+        constexpr uint32_t unused = std::numeric_limits<uint32_t>::max();
+        std::vector<uint32_t> remap(mesh.vertices.size(), unused);
+        std::vector<Model::Vertex> ordered;
+        ordered.reserve(mesh.vertices.size());
+        for(uint32_t &index : mesh.indices) {
+            if(remap[index] == unused) {
+                remap[index] = C_UI32T(ordered.size());
+                ordered.push_back(mesh.vertices[index]);
+            }
+            index = remap[index];
+        }
+        // vertices no triangle uses are dropped
+        mesh.vertices = std::move(ordered);
+    }
+
+    void MeshOptimizer::optimize(MeshData &mesh, bool overdraw) {
+        if(mesh.indices.size() < 3) { return; }
+        const vnd::Timer timer{"mesh optimizer"};
+        const Stats before = analyze(mesh.indices, mesh.vertices.size());
+        optimizeVertexCache(mesh.indices, mesh.vertices.size());
+        if(overdraw) { optimizeOverdraw(mesh.indices, mesh.vertices); }
+        optimizeVertexFetch(mesh);
+        const Stats after = analyze(mesh.indices, mesh.vertices.size());
+        LINFO("Mesh optimized in {}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, overfetch {:.2f} -> {:.2f}",
+              vnd::Timer::make_time_str(timer.make_time()), before.acmr, after.acmr, before.atvr, after.atvr, before.overfetch,
+              after.overfetch);
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner, *-avoid-magic-numbers, *-magic-numbers)
@@ -0,0 +1,180 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#include "vkl/Model.hpp"
+
+#include "vkl/UploadEngine.hpp"
+#include "vkl/cast/Quantize.hpp"
+
+namespace lve {
+
+    std::vector<VkVertexInputBindingDescription> Model::Vertex::getBindingDescriptions() {
+        const auto &bindings = VertexLayout<Vertex>::bindings;
+        return {bindings.begin(), bindings.end()};
+    }
+
+    std::vector<VkVertexInputAttributeDescription> Model::Vertex::getAttributeDescriptions() {
+        const auto &attributes = VertexLayout<Vertex>::attributes;
+        return {attributes.begin(), attributes.end()};
+    }
+
+    std::vector<VkVertexInputBindingDescription> Model::QuantizedVertex::getBindingDescriptions() {
+        const auto &bindings = VertexLayout<QuantizedVertex>::bindings;
+        return {bindings.begin(), bindings.end()};
+    }
+
+    std::vector<VkVertexInputAttributeDescription> Model::QuantizedVertex::getAttributeDescriptions() {
+        const auto &attributes = VertexLayout<QuantizedVertex>::attributes;
+        return {attributes.begin(), attributes.end()};
+    }
+
+    std::vector<Model::QuantizedVertex> Model::quantizeVertices(std::span<const Vertex> vertices) {
+        // the kernels work on contiguous lanes, so the attributes are split out first
+        const std::size_t count = vertices.size();
+        std::vector<float> positions(count * 4);
+        std::vector<float> colors(count * 4);
+        std::vector<float> uvs(count * 2);
+        std::vector<float> normals(count * 5);
+        const std::span<float> normalX{normals.data(), count};
+        const std::span<float> normalY{normals.data() + count, count};
+        const std::span<float> normalZ{normals.data() + count * 2, count};
+        const std::span<float> octahedralU{normals.data() + count * 3, count};
+        const std::span<float> octahedralV{normals.data() + count * 4, count};
+        std::size_t clampedUvs = 0;
+        for(std::size_t index = 0; index < count; index++) {
+            const Vertex &vertex = vertices[index];
+            for(int component = 0; component < 3; component++) {
+                positions[index * 4 + C_ST(component)] = vertex.position[component];
+                colors[index * 4 + C_ST(component)] = vertex.color[component];
+            }
+            positions[index * 4 + 3] = 1.0f;
+            colors[index * 4 + 3] = 1.0f;
+            uvs[index * 2] = vertex.uv.x;
+            uvs[index * 2 + 1] = vertex.uv.y;
+            normalX[index] = vertex.normal.x;
+            normalY[index] = vertex.normal.y;
+            normalZ[index] = vertex.normal.z;
+            const bool outside = vertex.uv.x < 0.0f || vertex.uv.y < 0.0f || vertex.uv.x > 1.0f || vertex.uv.y > 1.0f;
+            clampedUvs += outside ? 1 : 0;
+        }
+        if(clampedUvs > 0) { LWARN("{} of {} vertices have uvs outside [0, 1], they are clamped by quantization", clampedUvs, count); }
+
+        std::vector<uint16_t> halfPositions(positions.size());
+        std::vector<uint8_t> colorBytes(colors.size());
+        std::vector<uint16_t> uvWords(uvs.size());
+        std::vector<int16_t> normalWords(count * 2);
+        quantize::toHalf(positions, halfPositions);
+        quantize::toUnorm8(colors, colorBytes);
+        quantize::toUnorm16(uvs, uvWords);
+        quantize::toOctahedral(normalX, normalY, normalZ, octahedralU, octahedralV);
+        quantize::toSnorm16(std::span{normals}.subspan(count * 3), normalWords);
+
+        std::vector<QuantizedVertex> quantized(count);
+        for(std::size_t index = 0; index < count; index++) {
+            QuantizedVertex &vertex = quantized[index];
+            std::copy_n(halfPositions.begin() + C_LL(index * 4), 4, vertex.position.value.begin());
+            std::copy_n(colorBytes.begin() + C_LL(index * 4), 4, vertex.color.value.begin());
+            vertex.normal.value = {normalWords[index], normalWords[count + index]};
+            vertex.uv.value = {uvWords[index * 2], uvWords[index * 2 + 1]};
+        }
+        return quantized;
+    }
+
+    Model::Bounds Model::Bounds::of(std::span<const Vertex> vertices) noexcept {
+        Bounds bounds{};
+        if(vertices.empty()) { return bounds; }
+        bounds.min = bounds.max = vertices.front().position;
+        for(const Vertex &vertex : vertices) {
+            bounds.min = glm::min(bounds.min, vertex.position);
+            bounds.max = glm::max(bounds.max, vertex.position);
+        }
+        bounds.center = (bounds.min + bounds.max) * 0.5f;
+        for(const Vertex &vertex : vertices) { bounds.radius = std::max(bounds.radius, glm::distance(bounds.center, vertex.position)); }
+        return bounds;
+    }
+
+    Model::Model(Device &device, std::span<const Vertex> vertices, std::span<const uint32_t> indices)
+      : lveDevice{device}, vertexStride_{sizeof(Vertex)}, vertexCount_{C_UI32T(vertices.size())}, indexCount_{C_UI32T(indices.size())},
+        indexType_{indexTypeFor(vertices.size())}, bounds_{Bounds::of(vertices)} {
+        uploadIndexed(std::as_bytes(vertices), indices);
+    }
+
+    Model::Model(Device &device, std::span<const QuantizedVertex> vertices, std::span<const uint32_t> indices, const Bounds &bounds)
+      : lveDevice{device}, vertexStride_{sizeof(QuantizedVertex)}, vertexCount_{C_UI32T(vertices.size())},
+        indexCount_{C_UI32T(indices.size())}, indexType_{indexTypeFor(vertices.size())}, bounds_{bounds} {
+        uploadIndexed(std::as_bytes(vertices), indices);
+    }
+
+    Model::Model(Device &device, std::span<const std::byte> vertexData, uint32_t vertexStride, std::span<const std::byte> indexData,
+                 VkIndexType indexType, const Bounds &bounds)
+      : lveDevice{device}, vertexStride_{vertexStride}, vertexCount_{C_UI32T(vertexData.size() / vertexStride)},
+        indexCount_{C_UI32T(indexData.size() / indexSize(indexType))}, indexType_{indexType}, bounds_{bounds} {
+        upload(vertexData, indexData.size(),
+               [indexData](std::byte *destination) { std::memcpy(destination, indexData.data(), indexData.size()); });
+    }
+
+    void Model::uploadIndexed(std::span<const std::byte> vertexData, std::span<const uint32_t> indices) {
+        upload(vertexData, indexSize(indexType_) * indexCount_, [this, indices](std::byte *destination) {
+            if(indexType_ == VK_INDEX_TYPE_UINT16) {
+                std::ranges::transform(indices, reinterpret_cast<uint16_t *>(destination),  // NOLINT(*-reinterpret-cast)
+                                       [](uint32_t index) { return static_cast<uint16_t>(index); });
+            } else {
+                std::memcpy(destination, indices.data(), indices.size_bytes());
+            }
+        });
+    }
+
+    template <typename WriteIndices>
+    void Model::upload(std::span<const std::byte> vertexData, VkDeviceSize indexBytes, WriteIndices &&writeIndices) {
+        if(vertexCount_ == 0) [[unlikely]] { throw std::invalid_argument("a model needs at least one vertex"); }
+        const VkDeviceSize vertexBytes = vertexData.size();
+
+        VkBuffer stagingBuffer{};
+        Allocation stagingAllocation{};
+        lveDevice.createBuffer(vertexBytes + indexBytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer,
+                               stagingAllocation);
+        auto *staging = static_cast<std::byte *>(stagingAllocation.mapped);
+        std::memcpy(staging, vertexData.data(), C_ST(vertexBytes));
+        if(indexBytes > 0) { std::forward<WriteIndices>(writeIndices)(staging + vertexBytes); }
+
+        lveDevice.createBuffer(vertexBytes, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vertexBuffer, vertexAllocation);
+        auto &uploader = lveDevice.uploader();
+        auto batch = uploader.beginBatch();
+        batch.copyBuffer(stagingBuffer, vertexBuffer, vertexBytes);
+        if(indexBytes > 0) {
+            lveDevice.createBuffer(indexBytes, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, indexBuffer, indexAllocation);
+            batch.copyBuffer(stagingBuffer, indexBuffer, indexBytes, vertexBytes);
+        }
+        uploader.wait(uploader.flush(std::move(batch)));
+        lveDevice.destroyBuffer(stagingBuffer, stagingAllocation);
+    }
+
+    Model::Model(Device &device, const MeshData &mesh) : Model{device, mesh.vertices, mesh.indices} {}
+
+    Model::~Model() {
+        lveDevice.destroyBuffer(vertexBuffer, vertexAllocation);
+        if(indexBuffer != VK_NULL_HANDLE) { lveDevice.destroyBuffer(indexBuffer, indexAllocation); }
+    }
+
+    void Model::bind(VkCommandBuffer commandBuffer) const {
+        const std::array<VkBuffer, 1> buffers{vertexBuffer};
+        const std::array<VkDeviceSize, 1> offsets{0};
+        vkCmdBindVertexBuffers(commandBuffer, 0, C_UI32T(buffers.size()), buffers.data(), offsets.data());
+        if(indexCount_ > 0) { vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, indexType_); }
+    }
+
+    void Model::draw(VkCommandBuffer commandBuffer, uint32_t instanceCount) const {
+        if(indexCount_ > 0) {
+            vkCmdDrawIndexed(commandBuffer, indexCount_, instanceCount, 0, 0, 0);
+        } else {
+            vkCmdDraw(commandBuffer, vertexCount_, instanceCount, 0, 0);
+        }
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
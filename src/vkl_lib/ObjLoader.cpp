@@ -0,0 +1,325 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner, *-pointer-arithmetic)
+#include "vkl/ObjLoader.hpp"
+
+#include "vkl/MappedFile.hpp"
+#include "vkl/timer/Timer.hpp"
+
+#include <bit>
+
+namespace lve {
+
+    namespace {
+        enum class Statement : uint8_t { Position, Uv, Normal, Face, Other };
+
+        struct Range {
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        struct AttributeCounts {
+            std::size_t positions = 0;
+            std::size_t uvs = 0;
+            std::size_t normals = 0;
+        };
+
+        // global 0-based attribute indices, -1 when the corner has no uv or normal
+        struct Corner {
+            int64_t position;
+            int64_t uv;
+            int64_t normal;
+        };
+
+        struct Attributes {
+            std::vector<glm::vec3> positions;
+            std::vector<glm::vec3> colors;
+            std::vector<glm::vec2> uvs;
+            std::vector<glm::vec3> normals;
+        };
+
+        /// Flat open addressing set of vertex indices, compared through the vertices they point at.
+        class VertexSlots {
+        public:
+            explicit VertexSlots(std::size_t expected) : slots(std::bit_ceil(std::max(expected * 2, std::size_t{16})), emptySlot) {}
+
+            uint32_t findOrInsert(const Model::Vertex &vertex, std::vector<Model::Vertex> &vertices) {
+                std::size_t slot = slotOf(vertex);
+                while(slots[slot] != emptySlot) {
+                    if(vertices[slots[slot]] == vertex) { return slots[slot]; }
+                    slot = (slot + 1) & (slots.size() - 1);
+                }
+                const auto index = C_UI32T(vertices.size());
+                vertices.push_back(vertex);
+                slots[slot] = index;
+                if(vertices.size() * 2 > slots.size()) { grow(vertices); }
+                return index;
+            }
+
+        private:
+            static constexpr uint32_t emptySlot = std::numeric_limits<uint32_t>::max();
+
+            // the combined member hashes are weak in the low bits linear probing looks at, so they are mixed first
+            [[nodiscard]] std::size_t slotOf(const Model::Vertex &vertex) const noexcept {
+                const uint64_t hash = std::hash<Model::Vertex>{}(vertex) * 0x9E3779B97F4A7C15ULL;
+                return C_ST(hash ^ (hash >> 32)) & (slots.size() - 1);
+            }
+
+            void grow(const std::vector<Model::Vertex> &vertices) {
+                slots.assign(slots.size() * 2, emptySlot);
+                for(std::size_t index = 0; index < vertices.size(); index++) {
+                    std::size_t slot = slotOf(vertices[index]);
+                    while(slots[slot] != emptySlot) { slot = (slot + 1) & (slots.size() - 1); }
+                    slots[slot] = C_UI32T(index);
+                }
+            }
+
+            std::vector<uint32_t> slots;
+        };
+    }  // namespace
+
+    static bool isBlank(char character) noexcept { return character == ' ' || character == '\t'; }
+
+    static std::string_view trimFront(std::string_view text) noexcept {
+        std::size_t first = 0;
+        while(first < text.size() && isBlank(text[first])) { first++; }
+        return text.substr(first);
+    }
+
+    /// Strips the keyword off line and tells which statement it is.
+    static Statement classify(std::string_view &line) noexcept {
+        line = trimFront(line);
+        if(line.size() < 2) { return Statement::Other; }
+        if(line[0] == 'f' && isBlank(line[1])) {
+            line.remove_prefix(2);
+            return Statement::Face;
+        }
+        if(line[0] != 'v') { return Statement::Other; }
+        if(isBlank(line[1])) {
+            line.remove_prefix(2);
+            return Statement::Position;
+        }
+        if(line.size() < 3 || !isBlank(line[2])) { return Statement::Other; }
+        const char kind = line[1];
+        line.remove_prefix(3);
+        if(kind == 't') { return Statement::Uv; }
+        if(kind == 'n') { return Statement::Normal; }
+        return Statement::Other;
+    }
+
+    template <typename Function> static void forEachLine(std::string_view text, Function &&function) {
+        std::size_t position = 0;
+        while(position < text.size()) {
+            std::size_t end = text.find('\n', position);
+            if(end == std::string_view::npos) { end = text.size(); }
+            std::string_view line = text.substr(position, end - position);
+            if(!line.empty() && line.back() == '\r') { line.remove_suffix(1); }
+            function(line);
+            position = end + 1;
+        }
+    }
+
+    /// Splits text in about chunkCount ranges that each end right after a newline.
+    static std::vector<Range> splitLines(std::string_view text, std::size_t chunkCount) {
+        std::vector<Range> ranges;
+        ranges.reserve(chunkCount);
+        std::size_t begin = 0;
+        for(std::size_t chunk = 1; chunk < chunkCount && begin < text.size(); chunk++) {
+            const std::size_t target = std::max(text.size() * chunk / chunkCount, begin);
+            const std::size_t newline = text.find('\n', target);
+            if(newline == std::string_view::npos) { break; }
+            ranges.push_back({begin, newline + 1});
+            begin = newline + 1;
+        }
+        if(begin < text.size()) { ranges.push_back({begin, text.size()}); }
+        return ranges;
+    }
+
+    /// Parses up to out.size() floats until the end of text or a comment, returns how many were read or std::nullopt on garbage.
+    static std::optional<std::size_t> parseFloats(std::string_view text, std::span<float> out) noexcept {
+        const char *cursor = text.data();
+        const char *const end = text.data() + text.size();
+        std::size_t count = 0;
+        while(count < out.size()) {
+            while(cursor < end && isBlank(*cursor)) { cursor++; }
+            if(cursor == end || *cursor == '#') { break; }
+            if(*cursor == '+') { cursor++; }
+            const auto [next, error] = std::from_chars(cursor, end, out[count]);
+            if(error != std::errc{}) { return std::nullopt; }
+            cursor = next;
+            count++;
+        }
+        return count;
+    }
+
+    static const char *parseIndex(const char *cursor, const char *end, int64_t &value) noexcept {
+        if(cursor < end && *cursor == '+') { cursor++; }
+        const auto [next, error] = std::from_chars(cursor, end, value);
+        return error == std::errc{} ? next : nullptr;
+    }
+
+    /// OBJ indices are 1-based, negative ones count back from the last attribute defined so far.
+    static int64_t resolveIndex(int64_t index, std::size_t definedSoFar) noexcept {
+        return index > 0 ? index - 1 : C_LL(definedSoFar) + index;
+    }
+
+    static AttributeCounts countAttributes(std::string_view text) {
+        AttributeCounts counts;
+        forEachLine(text, [&counts](std::string_view line) {
+            switch(classify(line)) {
+            case Statement::Position:
+                counts.positions++;
+                break;
+            case Statement::Uv:
+                counts.uvs++;
+                break;
+            case Statement::Normal:
+                counts.normals++;
+                break;
+            default:
+                break;
+            }
+        });
+        return counts;
+    }
+
+    /// Parses one chunk, writing its attributes at base in attributes and appending its triangle corners to corners.
+    static void parseChunk(std::string_view text, AttributeCounts base, Attributes &attributes, std::vector<Corner> &corners,
+                           std::string_view path) {
+        const auto malformed = [path](std::string_view line) {
+            return std::runtime_error(FORMAT("{}: malformed OBJ statement '{}'", path, line));
+        };
+
+        std::vector<Corner> polygon;
+        forEachLine(text, [&](std::string_view line) {
+            const std::string_view original = line;
+            std::array<float, 6> values{};
+            switch(classify(line)) {
+            case Statement::Position: {
+                const auto count = parseFloats(line, values);
+                if(!count || *count < 3) { throw malformed(original); }
+                attributes.positions[base.positions] = {values[0], values[1], values[2]};
+                attributes.colors[base.positions] = *count >= 6 ? glm::vec3{values[3], values[4], values[5]} : glm::vec3{1.0f};
+                base.positions++;
+                break;
+            }
+            case Statement::Uv: {
+                const auto count = parseFloats(line, std::span{values}.first(3));
+                if(!count || *count < 1) { throw malformed(original); }
+                attributes.uvs[base.uvs++] = {values[0], values[1]};
+                break;
+            }
+            case Statement::Normal: {
+                const auto count = parseFloats(line, std::span{values}.first(3));
+                if(!count || *count < 3) { throw malformed(original); }
+                attributes.normals[base.normals++] = {values[0], values[1], values[2]};
+                break;
+            }
+            case Statement::Face: {
+                polygon.clear();
+                const char *cursor = line.data();
+                const char *const end = line.data() + line.size();
+                while(true) {
+                    while(cursor < end && isBlank(*cursor)) { cursor++; }
+                    if(cursor == end || *cursor == '#') { break; }
+
+                    int64_t position = 0;
+                    int64_t uv = 0;
+                    int64_t normal = 0;
+                    cursor = parseIndex(cursor, end, position);
+                    if(cursor != nullptr && cursor < end && *cursor == '/') {
+                        cursor++;
+                        if(cursor < end && *cursor != '/') { cursor = parseIndex(cursor, end, uv); }
+                        if(cursor != nullptr && cursor < end && *cursor == '/') { cursor = parseIndex(cursor + 1, end, normal); }
+                    }
+                    if(cursor == nullptr || position == 0 || (cursor < end && !isBlank(*cursor))) { throw malformed(original); }
+                    polygon.push_back({resolveIndex(position, base.positions), uv == 0 ? -1 : resolveIndex(uv, base.uvs),
+                                       normal == 0 ? -1 : resolveIndex(normal, base.normals)});
+                }
+                if(polygon.size() < 3) { throw malformed(original); }
+                for(std::size_t corner = 2; corner < polygon.size(); corner++) {
+                    corners.push_back(polygon[0]);
+                    corners.push_back(polygon[corner - 1]);
+                    corners.push_back(polygon[corner]);
+                }
+                break;
+            }
+            default:
+                break;
+            }
+        });
+    }
+
+    MeshData ObjLoader::load(const fs::path &path, ThreadPool &pool) {
+        const MappedFile file{path};
+        return parse(file.view(), pool, path.string());
+    }
+
+    MeshData ObjLoader::parse(std::string_view text, ThreadPool &pool, std::string_view path) {
+        const vnd::Timer timer{"obj"};
+        const std::size_t chunkCount =
+            std::clamp(text.size() / MIN_CHUNK_BYTES, std::size_t{1}, std::size_t{pool.threadCount()} * 4);
+        const std::vector<Range> ranges = splitLines(text, chunkCount);
+        const auto chunkText = [&](std::size_t chunk) { return text.substr(ranges[chunk].begin, ranges[chunk].end - ranges[chunk].begin); };
+
+        // first pass: attribute counts per chunk, turned into the global offset every chunk writes at
+        std::vector<AttributeCounts> bases(ranges.size() + 1);
+        pool.parallelFor(ranges.size(), [&](std::size_t chunk, uint32_t) { bases[chunk + 1] = countAttributes(chunkText(chunk)); });
+        for(std::size_t chunk = 1; chunk < bases.size(); chunk++) {
+            bases[chunk].positions += bases[chunk - 1].positions;
+            bases[chunk].uvs += bases[chunk - 1].uvs;
+            bases[chunk].normals += bases[chunk - 1].normals;
+        }
+        const AttributeCounts &totals = bases.back();
+
+        Attributes attributes;
+        attributes.positions.resize(totals.positions);
+        attributes.colors.resize(totals.positions);
+        attributes.uvs.resize(totals.uvs);
+        attributes.normals.resize(totals.normals);
+
+        std::vector<std::vector<Corner>> corners(ranges.size());
+        pool.parallelFor(ranges.size(), [&](std::size_t chunk, uint32_t) {
+            parseChunk(chunkText(chunk), bases[chunk], attributes, corners[chunk], path);
+        });
+        const long double parseNs = timer.make_time();
+
+        // deduplication: open addressing over the vertex values, grown so that at least half of the slots stay empty
+        std::size_t cornerCount = 0;
+        for(const auto &chunkCorners : corners) { cornerCount += chunkCorners.size(); }
+        if(cornerCount > std::numeric_limits<uint32_t>::max()) [[unlikely]] {
+            throw std::runtime_error(FORMAT("{}: {} face corners do not fit 32 bit indices", path, cornerCount));
+        }
+
+        MeshData mesh;
+        mesh.indices.reserve(cornerCount);
+        mesh.vertices.reserve(std::min(cornerCount, totals.positions));
+        VertexSlots slots{std::min(cornerCount, totals.positions)};
+        const auto inRange = [](int64_t index, std::size_t count) { return index >= 0 && C_ST(index) < count; };
+        for(const auto &chunkCorners : corners) {
+            for(const Corner &corner : chunkCorners) {
+                if(!inRange(corner.position, totals.positions) || (corner.uv >= 0 && !inRange(corner.uv, totals.uvs)) ||
+                   (corner.normal >= 0 && !inRange(corner.normal, totals.normals))) [[unlikely]] {
+                    throw std::runtime_error(FORMAT("{}: face references an attribute that does not exist", path));
+                }
+                Model::Vertex vertex{};
+                vertex.position = attributes.positions[C_ST(corner.position)];
+                vertex.color = attributes.colors[C_ST(corner.position)];
+                if(corner.normal >= 0) { vertex.normal = attributes.normals[C_ST(corner.normal)]; }
+                if(corner.uv >= 0) { vertex.uv = attributes.uvs[C_ST(corner.uv)]; }
+                mesh.indices.push_back(slots.findOrInsert(vertex, mesh.vertices));
+            }
+        }
+
+        const long double totalNs = timer.make_time();
+        const long double megabytes = C_LD(text.size()) / 1e6L;
+        LINFO("OBJ {}: {:.1f} MB parsed in {} ({:.1f} MB/s, {} chunks), total {} ({:.1f} MB/s); {} vertices from {} corners, {} triangles",
+              path, megabytes, vnd::Timer::make_time_str(parseNs), megabytes / (parseNs * 1e-9L), ranges.size(),
+              vnd::Timer::make_time_str(totalNs), megabytes / (totalNs * 1e-9L), mesh.vertices.size(), cornerCount, cornerCount / 3);
+        return mesh;
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner, *-pointer-arithmetic)
@@ -0,0 +1,206 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#include "vkl/OcclusionCuller.hpp"
+
+#include "vkl/Window.hpp"
+
+namespace lve {
+
+    namespace {
+        // objects, meshes, draw commands, draw count, visibility, stats
+        constexpr uint32_t STORAGE_BINDINGS = 6;
+        constexpr uint32_t PYRAMID_BINDING = STORAGE_BINDINGS;
+    }  // namespace
+
+    OcclusionCuller::OcclusionCuller(Device &device, const GpuScene &gpuScene, const DepthPyramid &depthPyramid, std::size_t framesInFlight)
+      : lveDevice{device}, scene{gpuScene}, pyramid{&depthPyramid}, slotObjects(framesInFlight, 0) {
+        if(scene.drawCommandBuffer() == VK_NULL_HANDLE) [[unlikely]] { throw std::logic_error("OcclusionCuller needs a built GpuScene"); }
+        lveDevice.createBuffer(VkDeviceSize{sizeof(uint32_t)} * std::max(scene.objectCount(), 1U),
+                               VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                               visibilityBuffer, visibilityAllocation);
+        lveDevice.createBuffer(VkDeviceSize{sizeof(uint32_t)} * 2,
+                               VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, statsBuffer, statsAllocation);
+        createDescriptors();
+        createPipelineLayout();
+        pipeline = MAKE_UNIQUE(ComputePipeline, lveDevice,
+                               Window::calculateRelativePathToSrcShaders(curentP, "occlusion_cull.comp.opt.rmp.spv").string(),
+                               pipelineLayout);
+
+        lveDevice.createBuffer(VkDeviceSize{sizeof(uint32_t)} * READBACK_SLOT_UINTS * framesInFlight, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, readbackBuffer,
+                               readbackAllocation);
+    }
+
+    OcclusionCuller::~OcclusionCuller() {
+        lveDevice.destroyBuffer(readbackBuffer, readbackAllocation);
+        pipeline.reset();
+        vkDestroyPipelineLayout(lveDevice.device(), pipelineLayout, nullptr);
+        vkDestroyDescriptorPool(lveDevice.device(), descriptorPool, nullptr);
+        vkDestroyDescriptorSetLayout(lveDevice.device(), setLayout, nullptr);
+        lveDevice.destroyBuffer(statsBuffer, statsAllocation);
+        lveDevice.destroyBuffer(visibilityBuffer, visibilityAllocation);
+    }
+
+    void OcclusionCuller::createDescriptors() {
+        const std::array<VkBuffer, STORAGE_BINDINGS> buffers{scene.objectBuffer(),      scene.meshBuffer(), scene.drawCommandBuffer(),
+                                                             scene.drawCountBuffer(), visibilityBuffer,   statsBuffer};
+
+        std::array<VkDescriptorSetLayoutBinding, STORAGE_BINDINGS + 1> bindings{};
+        for(uint32_t binding = 0; binding < C_UI32T(bindings.size()); binding++) {
+            bindings[binding] = VkDescriptorSetLayoutBinding{.binding = binding,
+                                                             .descriptorType = binding == PYRAMID_BINDING
+                                                                                   ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
+                                                                                   : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                                             .descriptorCount = 1,
+                                                             .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+                                                             .pImmutableSamplers = nullptr};
+        }
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = C_UI32T(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+        VK_CHECK(vkCreateDescriptorSetLayout(lveDevice.device(), &layoutInfo, nullptr, &setLayout),
+                 "failed to create occlusion cull descriptor set layout!");
+
+        const std::array<VkDescriptorPoolSize, 2> poolSizes{
+            VkDescriptorPoolSize{.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .descriptorCount = STORAGE_BINDINGS},
+            VkDescriptorPoolSize{.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .descriptorCount = 1}};
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets = 1;
+        poolInfo.poolSizeCount = C_UI32T(poolSizes.size());
+        poolInfo.pPoolSizes = poolSizes.data();
+        VK_CHECK(vkCreateDescriptorPool(lveDevice.device(), &poolInfo, nullptr, &descriptorPool),
+                 "failed to create occlusion cull descriptor pool!");
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &setLayout;
+        VK_CHECK(vkAllocateDescriptorSets(lveDevice.device(), &allocInfo, &descriptorSet),
+                 "failed to allocate occlusion cull descriptor set!");
+
+        std::array<VkDescriptorBufferInfo, STORAGE_BINDINGS> bufferInfos{};
+        std::array<VkWriteDescriptorSet, STORAGE_BINDINGS> writes{};
+        for(uint32_t binding = 0; binding < STORAGE_BINDINGS; binding++) {
+            bufferInfos[binding] = VkDescriptorBufferInfo{.buffer = buffers[binding], .offset = 0, .range = VK_WHOLE_SIZE};
+            writes[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[binding].dstSet = descriptorSet;
+            writes[binding].dstBinding = binding;
+            writes[binding].descriptorCount = 1;
+            writes[binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[binding].pBufferInfo = &bufferInfos[binding];
+        }
+        vkUpdateDescriptorSets(lveDevice.device(), C_UI32T(writes.size()), writes.data(), 0, nullptr);
+        writePyramidDescriptor();
+    }
+
+    void OcclusionCuller::writePyramidDescriptor() {
+        const VkDescriptorImageInfo imageInfo{
+            .sampler = pyramid->sampler(), .imageView = pyramid->view(), .imageLayout = VK_IMAGE_LAYOUT_GENERAL};
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = descriptorSet;
+        write.dstBinding = PYRAMID_BINDING;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.pImageInfo = &imageInfo;
+        vkUpdateDescriptorSets(lveDevice.device(), 1, &write, 0, nullptr);
+    }
+
+    void OcclusionCuller::setPyramid(const DepthPyramid &depthPyramid) {
+        pyramid = &depthPyramid;
+        writePyramidDescriptor();
+    }
+
+    void OcclusionCuller::createPipelineLayout() {
+        const VkPushConstantRange pushRange{.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT, .offset = 0, .size = sizeof(PushConstants)};
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &setLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushRange;
+        VK_CHECK(vkCreatePipelineLayout(lveDevice.device(), &pipelineLayoutInfo, nullptr, &pipelineLayout),
+                 "failed to create occlusion cull pipeline layout!");
+    }
+
+    void OcclusionCuller::recordEarly(VkCommandBuffer commandBuffer, std::size_t frameIndex, const glm::mat4 &viewProjection) {
+        record(commandBuffer, frameIndex % slotObjects.size(), viewProjection, Early);
+    }
+
+    void OcclusionCuller::recordLate(VkCommandBuffer commandBuffer, std::size_t frameIndex, const glm::mat4 &viewProjection) {
+        const std::size_t slot = frameIndex % slotObjects.size();
+        record(commandBuffer, slot, viewProjection, Late);
+        slotObjects[slot] = scene.objectCount();
+    }
+
+    void OcclusionCuller::record(VkCommandBuffer commandBuffer, std::size_t slot, const glm::mat4 &viewProjection, Phase phase) {
+        const uint32_t objectCount = scene.objectCount();
+        const VkBuffer drawBuffer = scene.drawCommandBuffer();
+        const VkBuffer countBuffer = scene.drawCountBuffer();
+        const VkDeviceSize slotOffset = VkDeviceSize{sizeof(uint32_t)} * READBACK_SLOT_UINTS * slot;
+
+        const auto memoryBarrier = [commandBuffer](VkPipelineStageFlags srcStage, VkAccessFlags srcAccess, VkPipelineStageFlags dstStage,
+                                                   VkAccessFlags dstAccess) {
+            const VkMemoryBarrier barrier{
+                .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER, .pNext = nullptr, .srcAccessMask = srcAccess, .dstAccessMask = dstAccess};
+            vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+        };
+
+        // the draws, copies and visibility reads of the previous phase still use what is rewritten here
+        memoryBarrier(VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                      VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0);
+        vkCmdFillBuffer(commandBuffer, countBuffer, 0, sizeof(uint32_t), 0);
+        if(!scene.drawsWithCount()) { vkCmdFillBuffer(commandBuffer, drawBuffer, 0, VK_WHOLE_SIZE, 0); }
+        if(phase == Early) {
+            vkCmdFillBuffer(commandBuffer, statsBuffer, 0, VK_WHOLE_SIZE, 0);
+            // nothing was visible before the first frame, the late phase draws everything it does not occlude
+            if(!visibilityCleared) {
+                vkCmdFillBuffer(commandBuffer, visibilityBuffer, 0, VK_WHOLE_SIZE, 0);
+                visibilityCleared = true;
+            }
+        }
+        memoryBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                      VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+        const VkExtent2D depthExtent = pyramid->depthExtent();
+        PushConstants constants{.viewProjection = viewProjection,
+                                .objectCount = objectCount,
+                                .phase = phase,
+                                .depthSize = glm::vec2{C_F(depthExtent.width), C_F(depthExtent.height)}};
+        pipeline->bind(commandBuffer);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+        vkCmdDispatch(commandBuffer, ComputePipeline::groupCount(objectCount, GROUP_SIZE), 1, 1);
+
+        memoryBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                      VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                      VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT);
+        const VkBufferCopy countCopy{.srcOffset = 0, .dstOffset = slotOffset + sizeof(uint32_t) * phase, .size = sizeof(uint32_t)};
+        vkCmdCopyBuffer(commandBuffer, countBuffer, readbackBuffer, 1, &countCopy);
+        if(phase == Late) {
+            const VkBufferCopy statsCopy{.srcOffset = 0, .dstOffset = slotOffset + sizeof(uint32_t) * 2, .size = sizeof(uint32_t) * 2};
+            vkCmdCopyBuffer(commandBuffer, statsBuffer, readbackBuffer, 1, &statsCopy);
+            memoryBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+                          VK_ACCESS_HOST_READ_BIT);
+        }
+    }
+
+    std::optional<OcclusionCuller::Stats> OcclusionCuller::stats(std::size_t frameIndex) const {
+        const std::size_t slot = frameIndex % slotObjects.size();
+        if(slotObjects[slot] == 0) { return std::nullopt; }
+        const uint32_t *values = static_cast<const uint32_t *>(readbackAllocation.mapped) + READBACK_SLOT_UINTS * slot;
+        return Stats{.earlyDraws = values[0],
+                     .lateDraws = values[1],
+                     .triangles = uint64_t{values[2]} + values[3],
+                     .culled = slotObjects[slot] - values[0] - values[1]};
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
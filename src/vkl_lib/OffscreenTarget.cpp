@@ -0,0 +1,240 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner, *-qualified-auto, *-non-const-parameter, *-const-correctness)
+#include "vkl/OffscreenTarget.hpp"
+
+namespace lve {
+
+    static void createAttachment(Device &device, VkExtent2D extent, VkFormat format, VkImageUsageFlags usage, VkImageAspectFlags aspect,
+                                 VkImage &image, Allocation &allocation, VkImageView &view, VkMemoryPropertyFlags preferred = 0) {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = extent.width;
+        imageInfo.extent.height = extent.height;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = format;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = usage;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        device.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, image, allocation, preferred);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = format;
+        viewInfo.subresourceRange.aspectMask = aspect;
+        viewInfo.subresourceRange.baseMipLevel = 0;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = 1;
+
+        VK_CHECK(vkCreateImageView(device.device(), &viewInfo, nullptr, &view), "failed to create offscreen image view!");
+    }
+
+    OffscreenTarget::OffscreenTarget(Device &deviceRef, VkExtent2D targetExtent, uint32_t count, VkFormat format)
+      : colorFormat{format}, extent{targetExtent}, device{deviceRef} {
+        if(count == 0) [[unlikely]] { throw std::invalid_argument("an offscreen target needs at least one image"); }
+        createColorResources(count);
+        createRenderPass();
+        createDepthResources();
+        createFramebuffers();
+        createSyncObjects();
+        LINFO("Offscreen target: {} images of {}x{}", count, extent.width, extent.height);
+    }
+
+    OffscreenTarget::~OffscreenTarget() {
+        const auto device_device = device.device();
+        for(auto framebuffer : framebuffers) { vkDestroyFramebuffer(device_device, framebuffer, nullptr); }
+
+        for(std::size_t i = 0; i < colorImages.size(); i++) {
+            vkDestroyImageView(device_device, colorImageViews[i], nullptr);
+            device.destroyImage(colorImages[i], colorImageAllocations[i]);
+        }
+        vkDestroyImageView(device_device, depthImageView, nullptr);
+        device.destroyImage(depthImage, depthImageAllocation);
+
+        vkDestroyRenderPass(device_device, renderPass, nullptr);
+
+        vkDestroySemaphore(device_device, timeline, nullptr);
+    }
+
+    uint64_t OffscreenTarget::completedFrame() const {
+        uint64_t value = 0;
+        VK_CHECK(vkGetSemaphoreCounterValue(device.device(), timeline, &value), "failed to read the frame timeline!");
+        return value;
+    }
+
+    void OffscreenTarget::waitForFrame(uint64_t frame) const {
+        if(frame == 0) { return; }
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &timeline;
+        waitInfo.pValues = &frame;
+        VK_CHECK(vkWaitSemaphores(device.device(), &waitInfo, std::numeric_limits<uint64_t>::max()), "failed to wait for a frame!");
+    }
+
+    VkResult OffscreenTarget::acquireNextImage(uint32_t *imageIndex) {
+        *imageIndex = nextImage;
+        nextImage = (nextImage + 1) % C_UI32T(colorImages.size());
+        waitForFrame(std::max(slotFrames[currentFrame], imageFrames[*imageIndex]));
+        return VK_SUCCESS;
+    }
+
+    VkResult OffscreenTarget::submitCommandBuffers(const VkCommandBuffer *buffers, uint32_t *imageIndex) {
+        const uint64_t frame = submittedFrames + 1;
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo{};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineInfo.signalSemaphoreValueCount = 1;
+        timelineInfo.pSignalSemaphoreValues = &frame;
+
+        VkSubmitInfo submitInfo = {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext = &timelineInfo;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = buffers;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &timeline;
+
+        const VkResult result = vkQueueSubmit(device.graphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
+        if(result == VK_SUCCESS) {
+            submittedFrames = frame;
+            slotFrames[currentFrame] = frame;
+            imageFrames[*imageIndex] = frame;
+        }
+
+        currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+
+        return result;
+    }
+
+    void OffscreenTarget::createColorResources(uint32_t count) {
+        colorImages.resize(count);
+        colorImageAllocations.resize(count);
+        colorImageViews.resize(count);
+        for(uint32_t i = 0; i < count; i++) {
+            createAttachment(device, extent, colorFormat, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                             VK_IMAGE_ASPECT_COLOR_BIT, colorImages[i], colorImageAllocations[i], colorImageViews[i]);
+        }
+    }
+
+    void OffscreenTarget::createDepthResources() {
+        constexpr VkImageUsageFlags usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        createAttachment(device, extent, findDepthFormat(), usage, VK_IMAGE_ASPECT_DEPTH_BIT, depthImage, depthImageAllocation, depthImageView,
+                         VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT);
+    }
+
+    void OffscreenTarget::createRenderPass() {
+        VkAttachmentDescription depthAttachment{};
+        depthAttachment.format = findDepthFormat();
+        depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+        depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        VkAttachmentReference depthAttachmentRef{};
+        depthAttachmentRef.attachment = 1;
+        depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        VkAttachmentDescription colorAttachment = {};
+        colorAttachment.format = colorFormat;
+        colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+        colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        colorAttachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+        VkAttachmentReference colorAttachmentRef = {};
+        colorAttachmentRef.attachment = 0;
+        colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+        VkSubpassDescription subpass = {};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount = 1;
+        subpass.pColorAttachments = &colorAttachmentRef;
+        subpass.pDepthStencilAttachment = &depthAttachmentRef;
+
+        // the first dependency orders depth writes on the shared depth image across frames, the second makes the
+        // rendered image visible to a readback copy recorded after the pass
+        std::array<VkSubpassDependency, 2> dependencies{};
+        dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+        dependencies[0].dstSubpass = 0;
+        dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                       VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        dependencies[0].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+        dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        dependencies[1].srcSubpass = 0;
+        dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+        dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        dependencies[1].dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        dependencies[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+        std::array<VkAttachmentDescription, 2> attachments = {colorAttachment, depthAttachment};
+        VkRenderPassCreateInfo renderPassInfo = {};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        renderPassInfo.attachmentCount = C_UI32T(attachments.size());
+        renderPassInfo.pAttachments = attachments.data();
+        renderPassInfo.subpassCount = 1;
+        renderPassInfo.pSubpasses = &subpass;
+        renderPassInfo.dependencyCount = C_UI32T(dependencies.size());
+        renderPassInfo.pDependencies = dependencies.data();
+
+        VK_CHECK(vkCreateRenderPass(device.device(), &renderPassInfo, nullptr, &renderPass), "failed to create offscreen render pass!");
+    }
+
+    void OffscreenTarget::createFramebuffers() {
+        framebuffers.resize(imageCount());
+        for(std::size_t i = 0; i < framebuffers.size(); i++) {
+            std::array<VkImageView, 2> attachments = {colorImageViews[i], depthImageView};
+
+            VkFramebufferCreateInfo framebufferInfo = {};
+            framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+            framebufferInfo.renderPass = renderPass;
+            framebufferInfo.attachmentCount = C_UI32T(attachments.size());
+            framebufferInfo.pAttachments = attachments.data();
+            framebufferInfo.width = extent.width;
+            framebufferInfo.height = extent.height;
+            framebufferInfo.layers = 1;
+
+            VK_CHECK(vkCreateFramebuffer(device.device(), &framebufferInfo, nullptr, &framebuffers[i]), "failed to create framebuffer!");
+        }
+    }
+
+    void OffscreenTarget::createSyncObjects() {
+        imageFrames.assign(imageCount(), 0);
+
+        VkSemaphoreTypeCreateInfo typeInfo{};
+        typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeInfo.initialValue = 0;
+
+        VkSemaphoreCreateInfo semaphoreInfo = {};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreInfo.pNext = &typeInfo;
+        VK_CHECK(vkCreateSemaphore(device.device(), &semaphoreInfo, nullptr, &timeline), "failed to create the frame timeline semaphore!");
+    }
+
+    VkFormat OffscreenTarget::findDepthFormat() {
+        return device.findSupportedFormat({VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT},
+                                          VK_IMAGE_TILING_OPTIMAL, VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT);
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner, *-qualified-auto, *-non-const-parameter, *-const-correctness)
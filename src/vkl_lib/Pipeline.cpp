@@ -49,7 +49,8 @@ namespace lve {
     void Pipeline::createGraphicsPipeline(const std::string &vertFilepath, const std::string &fragFilepath,
                                           const PipelineConfigInfo &configInfo) {
         assert(configInfo.pipelineLayout != VK_NULL_HANDLE && "Cannot create graphics pipeline: no pipelineLayout provided in configInfo");
-        assert(configInfo.renderPass != VK_NULL_HANDLE && "Cannot create graphics pipeline: no renderPass provided in configInfo");
+        assert((configInfo.renderPass != VK_NULL_HANDLE || configInfo.colorFormat != VK_FORMAT_UNDEFINED) &&
+               "Cannot create graphics pipeline: no renderPass or colorFormat provided in configInfo");
 
         const auto vertCode = readFile(vertFilepath);
         const auto fragCode = readFile(fragFilepath);
@@ -81,17 +82,23 @@ namespace lve {
 
         VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
         vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-        vertexInputInfo.vertexAttributeDescriptionCount = 0;
-        vertexInputInfo.vertexBindingDescriptionCount = 0;
-        vertexInputInfo.pVertexAttributeDescriptions = nullptr;
-        vertexInputInfo.pVertexBindingDescriptions = nullptr;
+        vertexInputInfo.vertexAttributeDescriptionCount = C_UI32T(configInfo.attributeDescriptions.size());
+        vertexInputInfo.vertexBindingDescriptionCount = C_UI32T(configInfo.bindingDescriptions.size());
+        vertexInputInfo.pVertexAttributeDescriptions = configInfo.attributeDescriptions.data();
+        vertexInputInfo.pVertexBindingDescriptions = configInfo.bindingDescriptions.data();
 
+        const auto isDynamic = [&configInfo](VkDynamicState state) { return std::ranges::contains(configInfo.dynamicStates, state); };
         VkPipelineViewportStateCreateInfo viewportInfo{};
         viewportInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
         viewportInfo.viewportCount = 1;
-        viewportInfo.pViewports = &configInfo.viewport;
+        viewportInfo.pViewports = isDynamic(VK_DYNAMIC_STATE_VIEWPORT) ? nullptr : &configInfo.viewport;
         viewportInfo.scissorCount = 1;
-        viewportInfo.pScissors = &configInfo.scissor;
+        viewportInfo.pScissors = isDynamic(VK_DYNAMIC_STATE_SCISSOR) ? nullptr : &configInfo.scissor;
+
+        VkPipelineDynamicStateCreateInfo dynamicStateInfo{};
+        dynamicStateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        dynamicStateInfo.dynamicStateCount = C_UI32T(configInfo.dynamicStates.size());
+        dynamicStateInfo.pDynamicStates = configInfo.dynamicStates.data();
 
         VkGraphicsPipelineCreateInfo pipelineInfo{};
         pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
@@ -104,7 +111,7 @@ namespace lve {
         pipelineInfo.pMultisampleState = &configInfo.multisampleInfo;
         pipelineInfo.pColorBlendState = &configInfo.colorBlendInfo;
         pipelineInfo.pDepthStencilState = &configInfo.depthStencilInfo;
-        pipelineInfo.pDynamicState = nullptr;
+        pipelineInfo.pDynamicState = configInfo.dynamicStates.empty() ? nullptr : &dynamicStateInfo;
 
         pipelineInfo.layout = configInfo.pipelineLayout;
         pipelineInfo.renderPass = configInfo.renderPass;
@@ -113,8 +120,36 @@ namespace lve {
         pipelineInfo.basePipelineIndex = -1;
         pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
 
-        VK_CHECK(vkCreateGraphicsPipelines(lveDevice.device(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &graphicsPipeline),
-                 "failed to create graphics pipeline");
+        // creation feedback tells whether the driver actually served the pipeline from the cache
+        VkPipelineCreationFeedback pipelineFeedback{};
+        VkPipelineCreationFeedbackCreateInfo feedbackInfo{};
+        feedbackInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO;
+        feedbackInfo.pPipelineCreationFeedback = &pipelineFeedback;
+
+        VkPipelineRenderingCreateInfo renderingInfo{};
+        if(configInfo.renderPass == VK_NULL_HANDLE) {
+            renderingInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+            renderingInfo.colorAttachmentCount = 1;
+            renderingInfo.pColorAttachmentFormats = &configInfo.colorFormat;
+            renderingInfo.depthAttachmentFormat = configInfo.depthFormat;
+            pipelineInfo.pNext = &renderingInfo;
+        }
+        if(lveDevice.supportsPipelineCreationFeedback()) {
+            feedbackInfo.pNext = pipelineInfo.pNext;
+            pipelineInfo.pNext = &feedbackInfo;
+        }
+
+        PipelineCache &cache = lveDevice.pipelineCache();
+        {
+            const vnd::AutoTimer timer(FORMAT("graphics pipeline creation ({})", cache.isWarm() ? "warm cache" : "cold compile"));
+            VK_CHECK(vkCreateGraphicsPipelines(lveDevice.device(), cache.handle(), 1, &pipelineInfo, nullptr, &graphicsPipeline),
+                     "failed to create graphics pipeline");
+        }
+        if(pipelineFeedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT) {
+            LINFO("Graphics pipeline: cache {}, driver time {} ns",
+                  pipelineFeedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT ? "hit" : "miss",
+                  pipelineFeedback.duration);
+        }
     }
 
     void Pipeline::createShaderModule(const std::vector<char> &code, VkShaderModule *shaderModule) {
@@ -130,22 +165,14 @@ namespace lve {
         vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
     }
 
-    PipelineConfigInfo Pipeline::defaultPipelineConfigInfo(uint32_t width, uint32_t height) {
-        PipelineConfigInfo configInfo{};
-
+    void Pipeline::defaultPipelineConfigInfo(PipelineConfigInfo &configInfo) {
         configInfo.inputAssemblyInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
         configInfo.inputAssemblyInfo.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
         configInfo.inputAssemblyInfo.primitiveRestartEnable = VK_FALSE;
 
-        configInfo.viewport.x = 0.0f;
-        configInfo.viewport.y = 0.0f;
-        configInfo.viewport.width = static_cast<float>(width);
-        configInfo.viewport.height = static_cast<float>(height);
-        configInfo.viewport.minDepth = 0.0f;
-        configInfo.viewport.maxDepth = 1.0f;
-
-        configInfo.scissor.offset = {0, 0};
-        configInfo.scissor.extent = {width, height};
+        configInfo.dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+        configInfo.bindingDescriptions = Model::Vertex::getBindingDescriptions();
+        configInfo.attributeDescriptions = Model::Vertex::getAttributeDescriptions();
 
         configInfo.rasterizationInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
         configInfo.rasterizationInfo.depthClampEnable = VK_FALSE;
@@ -197,8 +224,6 @@ namespace lve {
         configInfo.depthStencilInfo.stencilTestEnable = VK_FALSE;
         configInfo.depthStencilInfo.front = {};  // Optional
         configInfo.depthStencilInfo.back = {};   // Optional
-
-        return configInfo;
     }
 
 }  // namespace lve
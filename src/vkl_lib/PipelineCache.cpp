@@ -0,0 +1,120 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner, *-reinterpret-cast)
+#include "vkl/PipelineCache.hpp"
+
+#include "vkl/Util.hpp"
+
+namespace lve {
+
+    PipelineCache::PipelineCache(VkDevice device, const VkPhysicalDeviceProperties &properties, fs::path path)
+      : device_{device}, properties_{properties}, path_{std::move(path)} {
+        const std::vector<char> initialData = load();
+        warm = !initialData.empty();
+
+        VkPipelineCacheCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.initialDataSize = initialData.size();
+        createInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+        VK_CHECK(vkCreatePipelineCache(device_, &createInfo, nullptr, &cache), "failed to create pipeline cache!");
+        LINFO("Pipeline cache {}: {} ({} bytes)", warm ? "loaded" : "cold", path_.string(), initialData.size());
+    }
+
+    PipelineCache::~PipelineCache() {
+        try {
+            save();
+        } catch(const std::exception &e) { LWARN("Pipeline cache not saved: {}", e.what()); }
+        vkDestroyPipelineCache(device_, cache, nullptr);
+    }
+
+    PipelineCache::FileHeader PipelineCache::expectedHeader() const noexcept {
+        FileHeader header{};
+        header.vendorID = properties_.vendorID;
+        header.deviceID = properties_.deviceID;
+        header.driverVersion = properties_.driverVersion;
+        std::ranges::copy(properties_.pipelineCacheUUID, header.pipelineCacheUUID.begin());
+        return header;
+    }
+
+    std::vector<char> PipelineCache::load() const {
+        std::ifstream file{path_, std::ios::ate | std::ios::binary};  // NOLINT(*-signed-bitwise)
+        if(!file.is_open()) { return {}; }
+
+        const auto fileSize = C_ST(file.tellg());
+        if(fileSize < sizeof(FileHeader)) {
+            LWARN("Pipeline cache {} is truncated, ignoring it", path_.string());
+            return {};
+        }
+        file.seekg(0);
+
+        FileHeader header{};
+        file.read(reinterpret_cast<char *>(&header), sizeof(header));
+        const FileHeader expected = expectedHeader();
+        if(!file || header.magic != expected.magic || header.version != expected.version) {
+            LWARN("Pipeline cache {} has an unknown format, ignoring it", path_.string());
+            return {};
+        }
+        if(header.vendorID != expected.vendorID || header.deviceID != expected.deviceID || header.driverVersion != expected.driverVersion ||
+           header.pipelineCacheUUID != expected.pipelineCacheUUID) {
+            LINFO("Pipeline cache {} was produced by another device or driver, starting cold", path_.string());
+            return {};
+        }
+        if(header.dataSize != fileSize - sizeof(FileHeader)) {
+            LWARN("Pipeline cache {} is truncated, ignoring it", path_.string());
+            return {};
+        }
+
+        std::vector<char> data(C_ST(header.dataSize));
+        file.read(data.data(), C_LL(data.size()));
+        if(!file || fnv1a(data) != header.checksum) {
+            LWARN("Pipeline cache {} is corrupt, ignoring it", path_.string());
+            return {};
+        }
+
+        // the driver checks its own header too, but a mismatch there would silently give a cold cache
+        VkPipelineCacheHeaderVersionOne driverHeader{};
+        if(data.size() < sizeof(driverHeader)) { return {}; }
+        std::memcpy(&driverHeader, data.data(), sizeof(driverHeader));
+        if(driverHeader.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE || driverHeader.vendorID != expected.vendorID ||
+           driverHeader.deviceID != expected.deviceID ||
+           !std::ranges::equal(driverHeader.pipelineCacheUUID, expected.pipelineCacheUUID)) {
+            LWARN("Pipeline cache {} does not match the driver header, ignoring it", path_.string());
+            return {};
+        }
+        return data;
+    }
+
+    void PipelineCache::merge(std::span<const VkPipelineCache> sources) {
+        if(sources.empty()) { return; }
+        VK_CHECK(vkMergePipelineCaches(device_, cache, C_UI32T(sources.size()), sources.data()), "failed to merge pipeline caches!");
+    }
+
+    void PipelineCache::save() const {
+        std::size_t dataSize = 0;
+        VK_CHECK(vkGetPipelineCacheData(device_, cache, &dataSize, nullptr), "failed to query pipeline cache size!");
+        std::vector<char> data(dataSize);
+        VK_CHECK(vkGetPipelineCacheData(device_, cache, &dataSize, data.data()), "failed to read pipeline cache data!");
+        data.resize(dataSize);
+
+        FileHeader header = expectedHeader();
+        header.dataSize = data.size();
+        header.checksum = fnv1a(data);
+
+        // write next to the destination and rename over it, so a crash mid-write never leaves a torn cache behind
+        fs::path tmpPath = path_;
+        tmpPath += ".tmp";
+        {
+            std::ofstream file{tmpPath, std::ios::binary | std::ios::trunc};  // NOLINT(*-signed-bitwise)
+            if(!file.is_open()) [[unlikely]] { throw std::runtime_error(FORMAT("failed to open {}", tmpPath.string())); }
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            file.write(data.data(), C_LL(data.size()));
+            if(!file) [[unlikely]] { throw std::runtime_error(FORMAT("failed to write {}", tmpPath.string())); }
+        }
+        fs::rename(tmpPath, path_);
+        LINFO("Pipeline cache saved: {} ({} bytes)", path_.string(), data.size());
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner, *-reinterpret-cast)
@@ -0,0 +1,69 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#include "vkl/PresentPolicy.hpp"
+
+namespace lve {
+
+    static constexpr std::array presentModeNames{std::pair{PresentMode::Immediate, std::string_view{"immediate"}},
+                                                 std::pair{PresentMode::Mailbox, std::string_view{"mailbox"}},
+                                                 std::pair{PresentMode::Fifo, std::string_view{"fifo"}},
+                                                 std::pair{PresentMode::FifoRelaxed, std::string_view{"fifo_relaxed"}}};
+
+    std::string_view toString(PresentMode mode) noexcept {
+        const auto it = std::ranges::find(presentModeNames, mode, &decltype(presentModeNames)::value_type::first);
+        return it != presentModeNames.end() ? it->second : "unknown";
+    }
+
+    std::optional<PresentMode> parsePresentMode(std::string_view name) noexcept {
+        const auto it = std::ranges::find(presentModeNames, name, &decltype(presentModeNames)::value_type::second);
+        if(it == presentModeNames.end()) { return std::nullopt; }
+        return it->first;
+    }
+
+    VkPresentModeKHR toVkPresentMode(PresentMode mode) noexcept {
+        switch(mode) {
+        case PresentMode::Immediate:
+            return VK_PRESENT_MODE_IMMEDIATE_KHR;
+        case PresentMode::Mailbox:
+            return VK_PRESENT_MODE_MAILBOX_KHR;
+        case PresentMode::FifoRelaxed:
+            return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+        case PresentMode::Fifo:
+        default:
+            return VK_PRESENT_MODE_FIFO_KHR;
+        }
+    }
+
+    static std::optional<uint32_t> readUintEnv(const char *name) {
+        // NOLINTNEXTLINE(*-mt-unsafe)
+        const char *value = std::getenv(name);
+        if(value == nullptr) { return std::nullopt; }
+        const std::string_view text{value};
+        uint32_t result = 0;
+        if(std::from_chars(text.data(), text.data() + text.size(), result).ec != std::errc{}) {
+            LWARN("Ignoring {}={}: not an unsigned integer", name, text);
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    PresentPolicy PresentPolicy::fromEnvironment() {
+        PresentPolicy policy{};
+        // NOLINTNEXTLINE(*-mt-unsafe)
+        if(const char *mode = std::getenv("VKL_PRESENT_MODE"); mode != nullptr) {
+            if(const auto parsed = parsePresentMode(mode); parsed.has_value()) {
+                policy.mode = *parsed;
+            } else {
+                LWARN("Ignoring VKL_PRESENT_MODE={}: expected immediate, mailbox, fifo or fifo_relaxed", mode);
+            }
+        }
+        policy.imageCount = readUintEnv("VKL_SWAPCHAIN_IMAGES").value_or(policy.imageCount);
+        policy.framesInFlight = readUintEnv("VKL_FRAMES_IN_FLIGHT").value_or(policy.framesInFlight);
+        return policy;
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
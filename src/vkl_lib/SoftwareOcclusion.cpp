@@ -0,0 +1,303 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner, *-pointer-arithmetic)
+#include "vkl/SoftwareOcclusion.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define VKL_RASTER_AVX2 1
+#endif
+
+namespace lve {
+
+    namespace {
+        constexpr uint32_t lanes = 8;
+        static_assert(SoftwareOcclusion::TILE_WIDTH % lanes == 0, "tiles are rasterized eight pixels at a time");
+
+        /// One bit per clip plane the vertex is outside of; geometry whose vertices share a bit is outside the view.
+        uint32_t outcode(const glm::vec4 &clip) noexcept {
+            return (clip.x < -clip.w ? 1U : 0U) | (clip.x > clip.w ? 2U : 0U) | (clip.y < -clip.w ? 4U : 0U) | (clip.y > clip.w ? 8U : 0U) |
+                   (clip.z < 0.0f ? 16U : 0U) | (clip.z > clip.w ? 32U : 0U);
+        }
+
+        glm::vec3 toScreen(const glm::vec4 &clip, uint32_t width, uint32_t height) noexcept {
+            const float inverseW = 1.0f / clip.w;
+            return {(clip.x * inverseW * 0.5f + 0.5f) * C_F(width), (clip.y * inverseW * 0.5f + 0.5f) * C_F(height), clip.z * inverseW};
+        }
+    }  // namespace
+
+    SoftwareOcclusion::SoftwareOcclusion(uint32_t width, uint32_t height)
+      : width_{width}, height_{height}, tilesX{width / TILE_WIDTH}, tilesY{height / TILE_HEIGHT}, depth_(C_ST(width) * height, 1.0f),
+        tileMaxDepth(C_ST(tilesX) * tilesY, 1.0f), bins(tileMaxDepth.size()) {
+        if(width == 0 || height == 0 || width % TILE_WIDTH != 0 || height % TILE_HEIGHT != 0) [[unlikely]] {
+            throw std::runtime_error(
+                FORMAT("software occlusion buffer {}x{} is not made of whole {}x{} tiles!", width, height, TILE_WIDTH, TILE_HEIGHT));
+        }
+    }
+
+    void SoftwareOcclusion::render(std::span<const Occluder> occluders, const glm::mat4 &viewProjection, ThreadPool &pool) {
+        viewProjection_ = viewProjection;
+
+        // large occluders are split in several tasks, small ones share a task
+        const auto split = [&occluders](std::size_t perTask, auto &&countOf, std::vector<Range> &ranges, std::vector<std::size_t> &tasks) {
+            ranges.clear();
+            tasks.assign(1, 0);
+            std::size_t pending = 0;
+            for(std::size_t occluder = 0; occluder < occluders.size(); occluder++) {
+                const std::size_t count = countOf(occluders[occluder]);
+                for(std::size_t first = 0; first < count; first += perTask) {
+                    const std::size_t rangeCount = std::min(perTask, count - first);
+                    ranges.emplace_back(Range{occluder, first, rangeCount});
+                    pending += rangeCount;
+                    if(pending >= perTask) {
+                        tasks.emplace_back(ranges.size());
+                        pending = 0;
+                    }
+                }
+            }
+            if(pending > 0) { tasks.emplace_back(ranges.size()); }
+        };
+        split(VERTICES_PER_TASK, [](const Occluder &occluder) { return occluder.positions.size(); }, vertexRanges, vertexTasks);
+        split(TRIANGLES_PER_TASK, [](const Occluder &occluder) { return occluder.indices.size() / 3; }, triangleRanges, triangleTasks);
+        const std::size_t triangleTaskCount = triangleTasks.size() - 1;
+
+        // every vertex is transformed once, the triangles sharing it then read its clip space position
+        firstVertex.clear();
+        std::size_t vertexCount = 0;
+        for(const Occluder &occluder : occluders) {
+            firstVertex.emplace_back(vertexCount);
+            vertexCount += occluder.positions.size();
+        }
+        clipVertices.resize(vertexCount);
+        pool.parallelFor(vertexTasks.size() - 1, [&](std::size_t task, uint32_t /*thread*/) {
+            for(std::size_t range = vertexTasks[task]; range < vertexTasks[task + 1]; range++) {
+                const auto [occluderIndex, first, count] = vertexRanges[range];
+                const Occluder &occluder = occluders[occluderIndex];
+                const glm::mat4 modelViewProjection = viewProjection * occluder.transform;
+                glm::vec4 *clip = clipVertices.data() + firstVertex[occluderIndex];
+                for(std::size_t vertex = first; vertex < first + count; vertex++) {
+                    clip[vertex] = modelViewProjection * glm::vec4{occluder.positions[vertex], 1.0f};
+                }
+            }
+        });
+
+        if(taskTriangles.size() < triangleTaskCount) { taskTriangles.resize(triangleTaskCount); }
+        pool.parallelFor(triangleTaskCount, [&](std::size_t task, uint32_t /*thread*/) {
+            taskTriangles[task].clear();
+            for(std::size_t range = triangleTasks[task]; range < triangleTasks[task + 1]; range++) {
+                const auto [occluderIndex, first, count] = triangleRanges[range];
+                const Occluder &occluder = occluders[occluderIndex];
+                const std::span<const glm::vec4> clip{clipVertices.data() + firstVertex[occluderIndex], occluder.positions.size()};
+                setupTriangles(occluder, clip, first, count, taskTriangles[task]);
+            }
+        });
+
+        // binned in task order, so every tile draws its triangles in the same order whatever thread set them up
+        triangles.clear();
+        for(auto &bin : bins) { bin.clear(); }
+        for(std::size_t task = 0; task < triangleTaskCount; task++) {
+            for(const Triangle &triangle : taskTriangles[task]) {
+                const auto index = C_UI32T(triangles.size());
+                triangles.emplace_back(triangle);
+                for(uint32_t tileY = triangle.bounds[1] / TILE_HEIGHT; tileY <= triangle.bounds[3] / TILE_HEIGHT; tileY++) {
+                    for(uint32_t tileX = triangle.bounds[0] / TILE_WIDTH; tileX <= triangle.bounds[2] / TILE_WIDTH; tileX++) {
+                        bins[C_ST(tileY) * tilesX + tileX].emplace_back(index);
+                    }
+                }
+            }
+        }
+
+        pool.parallelFor(bins.size(), [this](std::size_t tile, uint32_t /*thread*/) { rasterizeTile(tile); });
+    }
+
+    void SoftwareOcclusion::setupTriangles(const Occluder &occluder, std::span<const glm::vec4> clip, std::size_t firstTriangle,
+                                           std::size_t triangleCount, std::vector<Triangle> &out) const {
+        for(std::size_t triangle = firstTriangle; triangle < firstTriangle + triangleCount; triangle++) {
+            const std::size_t first = triangle * 3;
+            clipTriangle({clip[occluder.indices[first]], clip[occluder.indices[first + 1]], clip[occluder.indices[first + 2]]}, out);
+        }
+    }
+
+    void SoftwareOcclusion::clipTriangle(const std::array<glm::vec4, 3> &clip, std::vector<Triangle> &out) const {
+        if((outcode(clip[0]) & outcode(clip[1]) & outcode(clip[2])) != 0) { return; }
+
+        // only the near plane z >= 0 needs clipping, the other planes are handled by the pixel bounds
+        std::array<glm::vec4, 4> polygon{};
+        std::size_t count = 0;
+        for(std::size_t corner = 0; corner < clip.size(); corner++) {
+            const glm::vec4 &current = clip[corner];
+            const glm::vec4 &next = clip[(corner + 1) % clip.size()];
+            if(current.z >= 0.0f) { polygon[count++] = current; }
+            if((current.z >= 0.0f) != (next.z >= 0.0f)) {
+                polygon[count++] = current + (next - current) * (current.z / (current.z - next.z));
+            }
+        }
+        if(std::ranges::any_of(std::span{polygon}.first(count), [](const glm::vec4 &vertex) { return vertex.w <= 0.0f; })) { return; }
+
+        const glm::vec3 first = toScreen(polygon[0], width_, height_);
+        for(std::size_t corner = 2; corner < count; corner++) {
+            addScreenTriangle(first, toScreen(polygon[corner - 1], width_, height_), toScreen(polygon[corner], width_, height_), out);
+        }
+    }
+
+    void SoftwareOcclusion::addScreenTriangle(glm::vec3 first, glm::vec3 second, glm::vec3 third, std::vector<Triangle> &out) const {
+        // set up in double: the edge constants of vertices far off screen cancel badly in float
+        const glm::dvec3 v0{first};
+        glm::dvec3 v1{second};
+        glm::dvec3 v2{third};
+        double area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+        if(area < 0.0) {
+            // both faces are drawn, the winding of an occluder does not matter
+            std::swap(v1, v2);
+            area = -area;
+        }
+        if(!(area > 0.0) || !std::isfinite(area)) { return; }
+
+        // pixels whose center may be covered
+        const double minX = std::max(std::ceil(std::min({v0.x, v1.x, v2.x}) - 0.5), 0.0);
+        const double minY = std::max(std::ceil(std::min({v0.y, v1.y, v2.y}) - 0.5), 0.0);
+        const double maxX = std::min(std::floor(std::max({v0.x, v1.x, v2.x}) - 0.5), C_D(width_ - 1));
+        const double maxY = std::min(std::floor(std::max({v0.y, v1.y, v2.y}) - 0.5), C_D(height_ - 1));
+        if(minX > maxX || minY > maxY) { return; }
+
+        // edge i is opposite vertex i: its value at a point is area times the barycentric weight of vertex i
+        const auto edge = [](const glm::dvec3 &from, const glm::dvec3 &to) {
+            return glm::dvec3{from.y - to.y, to.x - from.x, from.x * to.y - to.x * from.y};
+        };
+        const std::array<glm::dvec3, 3> edges{edge(v1, v2), edge(v2, v0), edge(v0, v1)};
+        const double depth1 = (v1.z - v0.z) / area;
+        const double depth2 = (v2.z - v0.z) / area;
+        const glm::dvec3 depthPlane{edges[1].x * depth1 + edges[2].x * depth2, edges[1].y * depth1 + edges[2].y * depth2,
+                                    v0.z + edges[1].z * depth1 + edges[2].z * depth2};
+
+        // the farthest depth the plane takes over the pixel square around the center
+        const double pixelBias = 0.5 * (std::abs(depthPlane.x) + std::abs(depthPlane.y));
+
+        out.emplace_back(Triangle{
+            .edges = {glm::vec3{edges[0]}, glm::vec3{edges[1]}, glm::vec3{edges[2]}},
+            .depthPlane = glm::vec3{glm::dvec3{depthPlane.x, depthPlane.y, depthPlane.z + pixelBias}},
+            .maxDepth = C_F(std::max({v0.z, v1.z, v2.z})),
+            .bounds = {C_UI32T(minX), C_UI32T(minY), C_UI32T(maxX), C_UI32T(maxY)},
+        });
+    }
+
+    void SoftwareOcclusion::rasterizeTile(std::size_t tile) noexcept {
+        const uint32_t tileX = C_UI32T(tile % tilesX) * TILE_WIDTH;
+        const uint32_t tileY = C_UI32T(tile / tilesX) * TILE_HEIGHT;
+        for(uint32_t y = tileY; y < tileY + TILE_HEIGHT; y++) { std::fill_n(depth_.data() + C_ST(y) * width_ + tileX, TILE_WIDTH, 1.0f); }
+
+        for(const uint32_t index : bins[tile]) {
+            const Triangle &triangle = triangles[index];
+            // whole groups of eight, which never cross the tile: the edge functions reject the extra pixels
+            const uint32_t x0 = std::max(triangle.bounds[0], tileX) / lanes * lanes;
+            const uint32_t x1 = std::min(triangle.bounds[2], tileX + TILE_WIDTH - 1);
+            const uint32_t y0 = std::max(triangle.bounds[1], tileY);
+            const uint32_t y1 = std::min(triangle.bounds[3], tileY + TILE_HEIGHT - 1);
+            const auto &[edge0, edge1, edge2] = triangle.edges;
+#ifdef VKL_RASTER_AVX2
+            const __m256 laneCenters = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+            const __m256 a0 = _mm256_set1_ps(edge0.x);
+            const __m256 a1 = _mm256_set1_ps(edge1.x);
+            const __m256 a2 = _mm256_set1_ps(edge2.x);
+            const __m256 depthX = _mm256_set1_ps(triangle.depthPlane.x);
+            const __m256 maxDepth = _mm256_set1_ps(triangle.maxDepth);
+            const __m256 zero = _mm256_setzero_ps();
+#endif
+            for(uint32_t y = y0; y <= y1; y++) {
+                const float py = C_F(y) + 0.5f;
+                float *row = depth_.data() + C_ST(y) * width_;
+                const float row0 = edge0.y * py + edge0.z;
+                const float row1 = edge1.y * py + edge1.z;
+                const float row2 = edge2.y * py + edge2.z;
+                const float depthRow = triangle.depthPlane.y * py + triangle.depthPlane.z;
+#ifdef VKL_RASTER_AVX2
+                const __m256 r0 = _mm256_set1_ps(row0);
+                const __m256 r1 = _mm256_set1_ps(row1);
+                const __m256 r2 = _mm256_set1_ps(row2);
+                const __m256 rowDepth = _mm256_set1_ps(depthRow);
+                for(uint32_t x = x0; x <= x1; x += lanes) {
+                    const __m256 px = _mm256_add_ps(_mm256_set1_ps(C_F(x)), laneCenters);
+                    const __m256 inside =
+                        _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(a0, px), r0), zero, _CMP_GE_OQ),
+                                                    _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(a1, px), r1), zero, _CMP_GE_OQ)),
+                                      _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(a2, px), r2), zero, _CMP_GE_OQ));
+                    if(_mm256_movemask_ps(inside) == 0) { continue; }
+                    const __m256 depth = _mm256_min_ps(_mm256_add_ps(_mm256_mul_ps(depthX, px), rowDepth), maxDepth);
+                    const __m256 current = _mm256_loadu_ps(row + x);
+                    _mm256_storeu_ps(row + x, _mm256_blendv_ps(current, _mm256_min_ps(current, depth), inside));
+                }
+#else
+                for(uint32_t x = x0; x <= x1; x += lanes) {
+                    for(uint32_t lane = 0; lane < lanes; lane++) {
+                        const float px = C_F(x) + (C_F(lane) + 0.5f);
+                        if(edge0.x * px + row0 >= 0.0f && edge1.x * px + row1 >= 0.0f && edge2.x * px + row2 >= 0.0f) {
+                            const float depth = std::min(triangle.depthPlane.x * px + depthRow, triangle.maxDepth);
+                            row[x + lane] = std::min(row[x + lane], depth);
+                        }
+                    }
+                }
+#endif
+            }
+        }
+
+        float farthest = 0.0f;
+        for(uint32_t y = tileY; y < tileY + TILE_HEIGHT; y++) {
+            const float *row = depth_.data() + C_ST(y) * width_ + tileX;
+            farthest = std::max(farthest, *std::max_element(row, row + TILE_WIDTH));
+        }
+        tileMaxDepth[tile] = farthest;
+    }
+
+    bool SoftwareOcclusion::isVisible(const glm::vec3 &min, const glm::vec3 &max) const noexcept {
+        glm::vec3 low{std::numeric_limits<float>::infinity()};
+        glm::vec3 high{-std::numeric_limits<float>::infinity()};
+        uint32_t outside = ~0U;
+        bool crossesNear = false;
+        // the corners are the min corner plus any of the projected edges along x, y and z
+        const glm::vec4 base = viewProjection_ * glm::vec4{min, 1.0f};
+        const glm::vec3 size = max - min;
+        const std::array<glm::vec4, 3> edges{viewProjection_[0] * size.x, viewProjection_[1] * size.y, viewProjection_[2] * size.z};
+        for(int corner = 0; corner < 8; corner++) {
+            glm::vec4 clip = base;
+            for(int axis = 0; axis < 3; axis++) {
+                if((corner >> axis) & 1) { clip += edges[C_ST(axis)]; }
+            }
+            outside &= outcode(clip);
+            if(clip.z < 0.0f || clip.w <= 0.0f) {
+                crossesNear = true;
+                continue;
+            }
+            const glm::vec3 screen = toScreen(clip, width_, height_);
+            low = glm::min(low, screen);
+            high = glm::max(high, screen);
+        }
+        if(outside != 0) { return false; }
+        // partly in front of the near plane: its projection is unbounded, keep it
+        if(crossesNear) { return true; }
+        if(high.x < 0.0f || high.y < 0.0f || low.x >= C_F(width_) || low.y >= C_F(height_)) { return false; }
+
+        // every pixel the box touches, not only those whose center it covers, so a box between the samples is still tested
+        const auto x0 = C_UI32T(std::max(std::floor(low.x), 0.0f));
+        const auto y0 = C_UI32T(std::max(std::floor(low.y), 0.0f));
+        const auto x1 = C_UI32T(std::min(std::floor(high.x), C_F(width_ - 1)));
+        const auto y1 = C_UI32T(std::min(std::floor(high.y), C_F(height_ - 1)));
+        for(uint32_t tileY = y0 / TILE_HEIGHT; tileY <= y1 / TILE_HEIGHT; tileY++) {
+            for(uint32_t tileX = x0 / TILE_WIDTH; tileX <= x1 / TILE_WIDTH; tileX++) {
+                // behind everything drawn in the tile
+                if(low.z > tileMaxDepth[C_ST(tileY) * tilesX + tileX]) { continue; }
+                const uint32_t lastX = std::min(x1, (tileX + 1) * TILE_WIDTH - 1);
+                for(uint32_t y = std::max(y0, tileY * TILE_HEIGHT); y <= std::min(y1, (tileY + 1) * TILE_HEIGHT - 1); y++) {
+                    const float *row = depth_.data() + C_ST(y) * width_;
+                    for(uint32_t x = std::max(x0, tileX * TILE_WIDTH); x <= lastX; x++) {
+                        if(low.z <= row[x]) { return true; }
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner, *-pointer-arithmetic)
@@ -0,0 +1,140 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner, *-pointer-arithmetic)
+#include "vkl/SphereCuller.hpp"
+
+#include <numeric>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define VKL_CULL_AVX2 1
+#endif
+
+namespace lve {
+
+    namespace {
+        /// Lanes of the set bits of every mask byte, in order: compaction writes all eight and advances by the popcount.
+        constexpr auto laneTable = [] {
+            std::array<std::array<uint8_t, BoundingSpheres::LANES>, 256> table{};
+            for(std::size_t mask = 0; mask < table.size(); mask++) {
+                std::size_t count = 0;
+                for(uint8_t lane = 0; lane < BoundingSpheres::LANES; lane++) {
+                    if((mask >> lane) & 1U) { table[mask][count++] = lane; }
+                }
+            }
+            return table;
+        }();
+    }  // namespace
+
+    bool SphereCuller::simd() noexcept {
+#ifdef VKL_CULL_AVX2
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    std::size_t SphereCuller::testBlocks(const BoundingSpheres &bounds, const Frustum &frustum, std::size_t firstBlock,
+                                         std::size_t blockCount, uint8_t *masks) noexcept {
+        constexpr std::size_t lanes = BoundingSpheres::LANES;
+        std::size_t visibleCount = 0;
+#ifdef VKL_CULL_AVX2
+        // the planes stay in registers for the whole range, each block is 4 aligned loads and 6 multiply-add chains
+        struct PlaneLanes {
+            __m256 x;
+            __m256 y;
+            __m256 z;
+            __m256 w;
+        };
+        std::array<PlaneLanes, 6> planes{};
+        for(std::size_t plane = 0; plane < planes.size(); plane++) {
+            const glm::vec4 &source = frustum.planes[plane];
+            planes[plane] =
+                PlaneLanes{_mm256_set1_ps(source.x), _mm256_set1_ps(source.y), _mm256_set1_ps(source.z), _mm256_set1_ps(source.w)};
+        }
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        for(std::size_t block = firstBlock; block < firstBlock + blockCount; block++) {
+            const std::size_t first = block * lanes;
+            const __m256 x = _mm256_load_ps(bounds.x() + first);
+            const __m256 y = _mm256_load_ps(bounds.y() + first);
+            const __m256 z = _mm256_load_ps(bounds.z() + first);
+            const __m256 negativeRadius = _mm256_xor_ps(_mm256_load_ps(bounds.radius() + first), signMask);
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for(const PlaneLanes &plane : planes) {
+                // same evaluation order as the scalar test: ((x * a + y * b) + z * c) + w
+                const __m256 distance = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, plane.x), _mm256_mul_ps(y, plane.y)), _mm256_mul_ps(z, plane.z)), plane.w);
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negativeRadius, _CMP_GE_OQ));
+            }
+            const auto mask = static_cast<uint8_t>(_mm256_movemask_ps(inside));
+            masks[block - firstBlock] = mask;
+            visibleCount += C_ST(std::popcount(mask));
+        }
+#else
+        for(std::size_t block = firstBlock; block < firstBlock + blockCount; block++) {
+            uint8_t mask = 0;
+            for(std::size_t lane = 0; lane < lanes; lane++) {
+                const std::size_t sphere = block * lanes + lane;
+                const glm::vec3 center{bounds.x()[sphere], bounds.y()[sphere], bounds.z()[sphere]};
+                const float negativeRadius = -bounds.radius()[sphere];
+                const bool inside = std::ranges::all_of(frustum.planes, [&](const glm::vec4 &plane) {
+                    return center.x * plane.x + center.y * plane.y + center.z * plane.z + plane.w >= negativeRadius;
+                });
+                mask |= static_cast<uint8_t>(inside ? 1U << lane : 0U);
+            }
+            masks[block - firstBlock] = mask;
+            visibleCount += C_ST(std::popcount(mask));
+        }
+#endif
+        return visibleCount;
+    }
+
+    std::span<const uint32_t> SphereCuller::cull(const BoundingSpheres &bounds, const Frustum &frustum, ThreadPool &pool) {
+        const std::size_t blockCount = bounds.blockCount();
+        const std::size_t taskCount = (blockCount + BLOCKS_PER_TASK - 1) / BLOCKS_PER_TASK;
+        masks.resize(blockCount);
+        taskOffsets.assign(taskCount + 1, 0);
+
+        const auto blockRange = [blockCount](std::size_t task) {
+            const std::size_t first = task * BLOCKS_PER_TASK;
+            return std::pair{first, std::min(BLOCKS_PER_TASK, blockCount - first)};
+        };
+        pool.parallelFor(taskCount, [&](std::size_t task, uint32_t /*thread*/) {
+            const auto [first, count] = blockRange(task);
+            taskOffsets[task + 1] = testBlocks(bounds, frustum, first, count, masks.data() + first);
+        });
+
+        // every task writes its indices from the total of the tasks before it, the result does not depend on scheduling
+        std::partial_sum(taskOffsets.begin(), taskOffsets.end(), taskOffsets.begin());
+        visible.resize(taskOffsets.back());
+        pool.parallelFor(taskCount, [&](std::size_t task, uint32_t /*thread*/) {
+            const auto [first, count] = blockRange(task);
+            uint32_t *out = visible.data() + taskOffsets[task];
+            uint32_t *const end = visible.data() + taskOffsets[task + 1];
+            for(std::size_t block = first; block < first + count; block++) {
+                const uint8_t mask = masks[block];
+                const auto base = C_UI32T(block * BoundingSpheres::LANES);
+                if(out + BoundingSpheres::LANES <= end) {
+                    // branch free: the lanes past the popcount are overwritten by the next block
+#ifdef VKL_CULL_AVX2
+                    // NOLINTNEXTLINE(*-reinterpret-cast)
+                    const __m128i lanes = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(laneTable[mask].data()));
+                    const __m256i indices = _mm256_add_epi32(_mm256_cvtepu8_epi32(lanes), _mm256_set1_epi32(C_I(base)));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), indices);  // NOLINT(*-reinterpret-cast)
+#else
+                    for(std::size_t lane = 0; lane < BoundingSpheres::LANES; lane++) { out[lane] = base + laneTable[mask][lane]; }
+#endif
+                    out += std::popcount(mask);
+                } else {
+                    // near the end of the task's range, where the extra lanes would land in the next task's
+                    for(int lane = 0; lane < std::popcount(mask); lane++) { *out++ = base + laneTable[mask][C_ST(lane)]; }
+                }
+            }
+        });
+        return visible;
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner, *-pointer-arithmetic)
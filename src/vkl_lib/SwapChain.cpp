@@ -6,13 +6,33 @@
 
 namespace lve {
 
-    SwapChain::SwapChain(Device &deviceRef, VkExtent2D extent) : device{deviceRef}, windowExtent{extent} {
-        createSwapChain();
+    SwapChain::SwapChain(Device &deviceRef, VkExtent2D extent, const PresentPolicy &presentPolicy, RenderingMode mode,
+                         std::unique_ptr<SwapChain> previous, bool sampledDepth)
+      : device{deviceRef}, windowExtent{extent}, policy_{presentPolicy}, renderingMode_{mode}, sampledDepth_{sampledDepth},
+        framesInFlight_{std::clamp(presentPolicy.framesInFlight, 1U, C_UI32T(MAX_FRAMES_IN_FLIGHT))} {
+        if(mode == RenderingMode::Dynamic && !device.supportsDynamicRendering()) [[unlikely]] {
+            throw std::runtime_error("dynamic rendering requested but not supported by the device!");
+        }
+        createSwapChain(previous ? previous->swapChain : VK_NULL_HANDLE);
         createImageViews();
-        createRenderPass();
+        depthFormat = findDepthFormat();
+        if(mode == RenderingMode::RenderPass) {
+            // the depth format only depends on the device, so an unchanged color format means a compatible render pass
+            // and pipelines built against it stay valid
+            if(previous && previous->renderPass != VK_NULL_HANDLE && previous->swapChainImageFormat == swapChainImageFormat) {
+                renderPass = std::exchange(previous->renderPass, VK_NULL_HANDLE);
+            } else {
+                createRenderPass();
+            }
+        }
         createDepthResources();
-        createFramebuffers();
-        createSyncObjects();
+        if(mode == RenderingMode::RenderPass) { createFramebuffers(); }
+        createRenderFinishedSemaphores();
+        if(previous) {
+            adopt(std::move(previous));
+        } else {
+            createSyncObjects();
+        }
     }
 
     SwapChain::~SwapChain() {
@@ -25,96 +45,125 @@ namespace lve {
             swapChain = nullptr;
         }
 
-        for(std::size_t i = 0; i < depthImages.size(); i++) {
-            vkDestroyImageView(device_device, depthImageViews[i], nullptr);
-            vkDestroyImage(device_device, depthImages[i], nullptr);
-            vkFreeMemory(device_device, depthImageMemorys[i], nullptr);
-        }
+        if(depthImageView != VK_NULL_HANDLE) { vkDestroyImageView(device_device, depthImageView, nullptr); }
+        if(depthImage != VK_NULL_HANDLE) { device.destroyImage(depthImage, depthImageAllocation); }
 
         for(auto framebuffer : swapChainFramebuffers) { vkDestroyFramebuffer(device_device, framebuffer, nullptr); }
 
-        vkDestroyRenderPass(device_device, renderPass, nullptr);
+        if(renderPass != VK_NULL_HANDLE) { vkDestroyRenderPass(device_device, renderPass, nullptr); }
 
-        // cleanup synchronization objects
-        for(size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-            vkDestroySemaphore(device_device, renderFinishedSemaphores[i], nullptr);
-            vkDestroySemaphore(device_device, imageAvailableSemaphores[i], nullptr);
-            vkDestroyFence(device_device, inFlightFences[i], nullptr);
+        // cleanup synchronization objects, empty when they were handed over to a recreated swapchain
+        for(auto semaphore : renderFinishedSemaphores) { vkDestroySemaphore(device_device, semaphore, nullptr); }
+        for(auto semaphore : imageAvailableSemaphores) { vkDestroySemaphore(device_device, semaphore, nullptr); }
+        if(timeline != VK_NULL_HANDLE) { vkDestroySemaphore(device_device, timeline, nullptr); }
+    }
+
+    void SwapChain::adopt(std::unique_ptr<SwapChain> previous) {
+        imageAvailableSemaphores = std::move(previous->imageAvailableSemaphores);
+        previous->imageAvailableSemaphores.clear();
+        timeline = std::exchange(previous->timeline, VK_NULL_HANDLE);
+        submittedFrames = previous->submittedFrames;
+        slotFrames = previous->slotFrames;
+        currentFrame = previous->currentFrame % framesInFlight_;
+        // a smaller frames-in-flight count drops slots, the one taking their place must also wait for their frames
+        for(std::size_t slot = framesInFlight_; slot < slotFrames.size(); slot++) {
+            auto &kept = slotFrames[slot % framesInFlight_];
+            kept = std::max(kept, slotFrames[slot]);
         }
+
+        retired = std::move(previous->retired);
+        previous->retired.clear();
+        retired.emplace_back(Retired{.swapChain = std::move(previous), .lastFrame = submittedFrames});
+    }
+
+    void SwapChain::destroyRetired() {
+        if(retired.empty()) { return; }
+        const uint64_t completed = completedFrame();
+        while(!retired.empty() && retired.front().lastFrame <= completed) { retired.pop_front(); }
+    }
+
+    uint64_t SwapChain::completedFrame() const {
+        uint64_t value = 0;
+        VK_CHECK(vkGetSemaphoreCounterValue(device.device(), timeline, &value), "failed to read the frame timeline!");
+        return value;
+    }
+
+    void SwapChain::waitForFrame(uint64_t frame) const {
+        if(frame == 0) { return; }
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &timeline;
+        waitInfo.pValues = &frame;
+        VK_CHECK(vkWaitSemaphores(device.device(), &waitInfo, std::numeric_limits<uint64_t>::max()), "failed to wait for a frame!");
     }
 
     VkResult SwapChain::acquireNextImage(uint32_t *imageIndex) {
 #ifdef INDEPTH
         // const vnd::AutoTimer timer{"acquireNextImage", vnd::Timer::Big};
 #endif
-        const auto device_device = device.device();
-        vkWaitForFences(device_device, 1, &inFlightFences[currentFrame], VK_TRUE, std::numeric_limits<uint64_t>::max());
-
-        const VkResult result = vkAcquireNextImageKHR(device_device, swapChain, std::numeric_limits<uint64_t>::max(),
-                                                      imageAvailableSemaphores[currentFrame],  // must be a not signaled semaphore
-                                                      VK_NULL_HANDLE, imageIndex);
-
-        return result;
+        // the frame that last used this slot must be done before its command buffer and per-frame data are reused;
+        // this is also what bounds the CPU to framesInFlight frames ahead of the GPU
+        waitForFrame(slotFrames[currentFrame]);
+        destroyRetired();
+
+        return vkAcquireNextImageKHR(device.device(), swapChain, std::numeric_limits<uint64_t>::max(),
+                                     imageAvailableSemaphores[currentFrame],  // must be a not signaled semaphore
+                                     VK_NULL_HANDLE, imageIndex);
     }
 
     VkResult SwapChain::submitCommandBuffers(const VkCommandBuffer *buffers, uint32_t *imageIndex) {
-        const auto device_device = device.device();
-        if(imagesInFlight[*imageIndex] != VK_NULL_HANDLE) {
-            vkWaitForFences(device_device, 1, &imagesInFlight[*imageIndex], VK_TRUE, UINT64_MAX);
-        }
-        imagesInFlight[*imageIndex] = inFlightFences[currentFrame];
+        const uint64_t frame = submittedFrames + 1;
+
+        const std::array<VkSemaphore, 1> waitSemaphores = {imageAvailableSemaphores[currentFrame]};
+        const std::array<VkPipelineStageFlags, 1> waitStages = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+        const std::array<VkSemaphore, 2> signalSemaphores = {renderFinishedSemaphores[*imageIndex], timeline};
+        const std::array<uint64_t, 2> signalValues = {0, frame};  // the binary semaphore ignores its value
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo{};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineInfo.signalSemaphoreValueCount = C_UI32T(signalValues.size());
+        timelineInfo.pSignalSemaphoreValues = signalValues.data();
 
         VkSubmitInfo submitInfo = {};
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-
-        std::vector<VkSemaphore> waitSemaphores = {imageAvailableSemaphores[currentFrame]};
-        std::vector<VkPipelineStageFlags> waitStages = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.pNext = &timelineInfo;
+        submitInfo.waitSemaphoreCount = C_UI32T(waitSemaphores.size());
         submitInfo.pWaitSemaphores = waitSemaphores.data();
         submitInfo.pWaitDstStageMask = waitStages.data();
-
         submitInfo.commandBufferCount = 1;
         submitInfo.pCommandBuffers = buffers;
-
-        std::vector<VkSemaphore> signalSemaphores = {renderFinishedSemaphores[currentFrame]};
-        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.signalSemaphoreCount = C_UI32T(signalSemaphores.size());
         submitInfo.pSignalSemaphores = signalSemaphores.data();
 
-        vkResetFences(device_device, 1, &inFlightFences[currentFrame]);
-        VK_CHECK(vkQueueSubmit(device.graphicsQueue(), 1, &submitInfo, inFlightFences[currentFrame]),
-                 "failed to submit draw command buffer!");
+        VK_CHECK(vkQueueSubmit(device.graphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE), "failed to submit draw command buffer!");
+        submittedFrames = frame;
+        slotFrames[currentFrame] = frame;
 
         VkPresentInfoKHR presentInfo = {};
         presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-
         presentInfo.waitSemaphoreCount = 1;
-        presentInfo.pWaitSemaphores = signalSemaphores.data();
-
-        std::vector<VkSwapchainKHR> swapChains = {swapChain};
+        presentInfo.pWaitSemaphores = &renderFinishedSemaphores[*imageIndex];
         presentInfo.swapchainCount = 1;
-        presentInfo.pSwapchains = swapChains.data();
-
+        presentInfo.pSwapchains = &swapChain;
         presentInfo.pImageIndices = imageIndex;
 
         auto result = vkQueuePresentKHR(device.presentQueue(), &presentInfo);
 
-        currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+        currentFrame = (currentFrame + 1) % framesInFlight_;
 
         return result;
     }
 
-    void SwapChain::createSwapChain() {
+    void SwapChain::createSwapChain(VkSwapchainKHR oldSwapChain) {
         const auto device_device = device.device();
         SwapChainSupportDetails swapChainSupport = device.getSwapChainSupport();
 
         VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
-        VkPresentModeKHR presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
+        presentMode_ = chooseSwapPresentMode(swapChainSupport.presentModes);
         VkExtent2D extent = chooseSwapExtent(swapChainSupport.capabilities);
 
-        uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;
-        if(swapChainSupport.capabilities.maxImageCount > 0 && imageCount > swapChainSupport.capabilities.maxImageCount) {
-            imageCount = swapChainSupport.capabilities.maxImageCount;
-        }
+        uint32_t imageCount = chooseImageCount(swapChainSupport.capabilities);
 
         VkSwapchainCreateInfoKHR createInfo = {};
         createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
@@ -143,10 +192,10 @@ namespace lve {
         createInfo.preTransform = swapChainSupport.capabilities.currentTransform;
         createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
 
-        createInfo.presentMode = presentMode;
+        createInfo.presentMode = presentMode_;
         createInfo.clipped = VK_TRUE;
 
-        createInfo.oldSwapchain = VK_NULL_HANDLE;
+        createInfo.oldSwapchain = oldSwapChain;
 
         VK_CHECK(vkCreateSwapchainKHR(device_device, &createInfo, nullptr, &swapChain), "failed to create swap chain!");
 
@@ -188,7 +237,7 @@ namespace lve {
     void SwapChain::createRenderPass() {
         const auto device_device = device.device();
         VkAttachmentDescription depthAttachment{};
-        depthAttachment.format = findDepthFormat();
+        depthAttachment.format = depthFormat;
         depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
         depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
         depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
@@ -221,14 +270,17 @@ namespace lve {
         subpass.pColorAttachments = &colorAttachmentRef;
         subpass.pDepthStencilAttachment = &depthAttachmentRef;
 
+        // the depth image is shared by all frames in flight: the fragment test stages and the depth write access make
+        // this frame's clear wait for the previous frame's depth writes (write-after-write on the same image)
         VkSubpassDependency dependency = {};
 
         dependency.dstSubpass = 0;
-        dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-        dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
         dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-        dependency.srcAccessMask = 0;
-        dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependency.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                  VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
 
         std::array<VkAttachmentDescription, 2> attachments = {colorAttachment, depthAttachment};
         VkRenderPassCreateInfo renderPassInfo = {};
@@ -253,7 +305,7 @@ namespace lve {
         auto imagectnviota = std::views::iota(C_ST(0), imagectn);
         // NOLINTBEGIN(*-identifier-length, *-lambda-function-name)
         std::for_each(std::execution::par, imagectnviota.begin(), imagectnviota.end(), [&](const auto i) {
-            std::array<VkImageView, 2> attachments = {swapChainImageViews[i], depthImageViews[i]};
+            std::array<VkImageView, 2> attachments = {swapChainImageViews[i], depthImageView};
 
             const VkExtent2D swapChainExtentm = getSwapChainExtent();
             VkFramebufferCreateInfo framebufferInfo = {};
@@ -275,71 +327,69 @@ namespace lve {
 #ifdef INDEPTH
         const vnd::AutoTimer timer{"createDepthResources", vnd::Timer::Big};
 #endif
-        const auto imagectn = imageCount();
-        const VkFormat depthFormat = findDepthFormat();
         const VkExtent2D dswapChainExtent = getSwapChainExtent();
         const auto device_device = device.device();
 
-        depthImages.resize(imagectn);
-        depthImageMemorys.resize(imagectn);
-        depthImageViews.resize(imagectn);
-        auto imagectnviota = std::views::iota(C_ST(0), imagectn);
-
-        // NOLINTBEGIN(*-identifier-length, *-lambda-function-name)
-        std::for_each(std::execution::par, imagectnviota.begin(), imagectnviota.end(), [&](const auto i) {
-            VkImageCreateInfo imageInfo{};
-            imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-            imageInfo.imageType = VK_IMAGE_TYPE_2D;
-            imageInfo.extent.width = dswapChainExtent.width;
-            imageInfo.extent.height = dswapChainExtent.height;
-            imageInfo.extent.depth = 1;
-            imageInfo.mipLevels = 1;
-            imageInfo.arrayLayers = 1;
-            imageInfo.format = depthFormat;
-            imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-            imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
-            imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-            imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-            imageInfo.flags = 0;
-
-            device.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, depthImages[i], depthImageMemorys[i]);
-
-            VkImageViewCreateInfo viewInfo{};
-            viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-            viewInfo.image = depthImages[i];
-            viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-            viewInfo.format = depthFormat;
-            viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-            viewInfo.subresourceRange.baseMipLevel = 0;
-            viewInfo.subresourceRange.levelCount = 1;
-            viewInfo.subresourceRange.baseArrayLayer = 0;
-            viewInfo.subresourceRange.layerCount = 1;
-
-            VK_CHECK(vkCreateImageView(device_device, &viewInfo, nullptr, &depthImageViews[i]), "failed to create texture image view!");
-        });
-        // NOLINTEND(*-identifier-length, *-lambda-function-name)
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = dswapChainExtent.width;
+        imageInfo.extent.height = dswapChainExtent.height;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = depthFormat;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        // unless it is sampled, depth never leaves the render pass, so tilers can keep it in on-chip memory and never back it
+        imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT |
+                          (sampledDepth_ ? VK_IMAGE_USAGE_SAMPLED_BIT : VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT);
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.flags = 0;
+
+        device.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, depthImage, depthImageAllocation,
+                                   sampledDepth_ ? 0 : VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = depthImage;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = depthFormat;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+        viewInfo.subresourceRange.baseMipLevel = 0;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = 1;
+
+        VK_CHECK(vkCreateImageView(device_device, &viewInfo, nullptr, &depthImageView), "failed to create texture image view!");
     }
 
     void SwapChain::createSyncObjects() {
         const auto device_device = device.device();
         imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-        renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-        inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
-        imagesInFlight.resize(imageCount(), VK_NULL_HANDLE);
 
         VkSemaphoreCreateInfo semaphoreInfo = {};
         semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        for(auto &semaphore : imageAvailableSemaphores) {
+            VK_CHECK(vkCreateSemaphore(device_device, &semaphoreInfo, nullptr, &semaphore), "failed to create synchronization objects for a frame!");
+        }
 
-        VkFenceCreateInfo fenceInfo = {};
-        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-        fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+        VkSemaphoreTypeCreateInfo typeInfo{};
+        typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeInfo.initialValue = 0;
+        semaphoreInfo.pNext = &typeInfo;
+        VK_CHECK(vkCreateSemaphore(device_device, &semaphoreInfo, nullptr, &timeline), "failed to create the frame timeline semaphore!");
+    }
+
+    void SwapChain::createRenderFinishedSemaphores() {
+        renderFinishedSemaphores.resize(imageCount());
 
-        for(size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-            VK_CHECK_SYNC_OBJECTS(vkCreateSemaphore(device_device, &semaphoreInfo, nullptr, &imageAvailableSemaphores[i]),
-                                  vkCreateSemaphore(device_device, &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]),
-                                  vkCreateFence(device_device, &fenceInfo, nullptr, &inFlightFences[i]),
-                                  "failed to create synchronization objects for a frame!");
+        VkSemaphoreCreateInfo semaphoreInfo = {};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        for(auto &semaphore : renderFinishedSemaphores) {
+            VK_CHECK(vkCreateSemaphore(device.device(), &semaphoreInfo, nullptr, &semaphore), "failed to create synchronization objects for a frame!");
         }
     }
 
@@ -356,24 +406,42 @@ namespace lve {
         return availableFormats[0];
     }
 
-    VkPresentModeKHR SwapChain::chooseSwapPresentMode(const std::vector<VkPresentModeKHR> &availablePresentModes) {
+    VkPresentModeKHR SwapChain::chooseSwapPresentMode(const std::vector<VkPresentModeKHR> &availablePresentModes) const {
 #ifdef INDEPTH
         const vnd::AutoTimer timer{"chooseSwapPresentMode", vnd::Timer::Big};
 #endif
-        if(std::ranges::find(availablePresentModes, VK_PRESENT_MODE_MAILBOX_KHR) != availablePresentModes.end()) {
-            LINFO("Present mode: Mailbox");
-            return VK_PRESENT_MODE_MAILBOX_KHR;
+        // closest alternative first: the tearing modes fall back to each other, FIFO is guaranteed to be supported
+        std::vector<PresentMode> preference{policy_.mode};
+        switch(policy_.mode) {
+        case PresentMode::Immediate:
+            preference.emplace_back(PresentMode::Mailbox);
+            break;
+        case PresentMode::Mailbox:
+            preference.emplace_back(PresentMode::Immediate);
+            break;
+        default:
+            break;
         }
 
-        // if(std::ranges::find(availablePresentModes, VK_PRESENT_MODE_IMMEDIATE_KHR) != availablePresentModes.end()) {
-        //     LINFO("Present mode: Immediate");
-        //     return VK_PRESENT_MODE_IMMEDIATE_KHR;
-        // }
+        for(const PresentMode mode : preference) {
+            if(std::ranges::contains(availablePresentModes, toVkPresentMode(mode))) {
+                LINFO("Present mode: {} (requested {})", toString(mode), toString(policy_.mode));
+                return toVkPresentMode(mode);
+            }
+        }
 
-        LINFO("Present mode: V-Sync");
+        LINFO("Present mode: fifo (requested {} is not supported)", toString(policy_.mode));
         return VK_PRESENT_MODE_FIFO_KHR;
     }
 
+    uint32_t SwapChain::chooseImageCount(const VkSurfaceCapabilitiesKHR &capabilities) const {
+        uint32_t imageCount = policy_.imageCount == 0 ? capabilities.minImageCount + 1 : policy_.imageCount;
+        imageCount = std::max(imageCount, capabilities.minImageCount);
+        if(capabilities.maxImageCount > 0) { imageCount = std::min(imageCount, capabilities.maxImageCount); }
+        LINFO("Swapchain images: {} (requested {}), frames in flight: {}", imageCount, policy_.imageCount, framesInFlight_);
+        return imageCount;
+    }
+
     VkExtent2D SwapChain::chooseSwapExtent(const VkSurfaceCapabilitiesKHR &capabilities) {
 #ifdef INDEPTH
         const vnd::AutoTimer timer{"chooseSwapExtent", vnd::Timer::Big};
@@ -0,0 +1,83 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner)
+#include "vkl/ThreadPool.hpp"
+
+namespace lve {
+
+    ThreadPool::ThreadPool(uint32_t threadCount) {
+        const uint32_t workerCount = std::max(threadCount, 1U) - 1;
+        workers.reserve(workerCount);
+        for(uint32_t thread = 1; thread <= workerCount; thread++) {
+            workers.emplace_back([this, thread](const std::stop_token &stopToken) { workerLoop(stopToken, thread); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        for(auto &worker : workers) { worker.request_stop(); }
+        wake.notify_all();
+        workers.clear();
+    }
+
+    uint32_t ThreadPool::defaultThreadCount() noexcept { return std::max(std::thread::hardware_concurrency(), 1U); }
+
+    void ThreadPool::parallelFor(std::size_t taskCount, const Task &task) {
+        if(taskCount == 0) { return; }
+        if(workers.empty() || taskCount == 1) {
+            for(std::size_t index = 0; index < taskCount; index++) { task(index, 0); }
+            return;
+        }
+
+        {
+            const std::scoped_lock lock{mutex};
+            job = &task;
+            jobSize = taskCount;
+            nextTask.store(0, std::memory_order_relaxed);
+            error = nullptr;
+            activeWorkers = C_UI32T(workers.size());
+            generation++;
+        }
+        wake.notify_all();
+
+        runTasks(0);
+
+        std::unique_lock lock{mutex};
+        done.wait(lock, [this] { return activeWorkers == 0; });
+        job = nullptr;
+        if(error) { std::rethrow_exception(std::exchange(error, nullptr)); }
+    }
+
+    void ThreadPool::workerLoop(const std::stop_token &stopToken, uint32_t thread) {
+        uint64_t seenGeneration = 0;
+        while(true) {
+            {
+                std::unique_lock lock{mutex};
+                if(!wake.wait(lock, stopToken, [this, seenGeneration] { return generation != seenGeneration; })) { return; }
+                seenGeneration = generation;
+            }
+
+            runTasks(thread);
+
+            const std::scoped_lock lock{mutex};
+            if(--activeWorkers == 0) { done.notify_one(); }
+        }
+    }
+
+    void ThreadPool::runTasks(uint32_t thread) noexcept {
+        for(std::size_t index = nextTask.fetch_add(1, std::memory_order_relaxed); index < jobSize;
+            index = nextTask.fetch_add(1, std::memory_order_relaxed)) {
+            try {
+                (*job)(index, thread);
+            } catch(...) {
+                const std::scoped_lock lock{mutex};
+                if(!error) { error = std::current_exception(); }
+                // skip the remaining tasks, the loop is failing anyway
+                nextTask.store(jobSize, std::memory_order_relaxed);
+            }
+        }
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner)
@@ -0,0 +1,320 @@
+//
+// Created by gbian on 17/10/2026.
+//
+// NOLINTBEGIN(*-include-cleaner, *-signed-bitwise)
+#include "vkl/UploadEngine.hpp"
+
+namespace lve {
+
+    UploadEngine::UploadEngine(Device &device) : lveDevice{device} {
+        const QueueFamilyIndices indices = lveDevice.findPhysicalQueueFamilies();
+        dedicated = indices.hasDedicatedTransfer();
+        transferFamily = dedicated ? indices.transferFamily : indices.graphicsFamily;
+        graphicsFamily = indices.graphicsFamily;
+        const auto device_device = lveDevice.device();
+
+        VkCommandPoolCreateInfo poolInfo = {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        poolInfo.queueFamilyIndex = transferFamily;
+        VK_CHECK(vkCreateCommandPool(device_device, &poolInfo, nullptr, &transferPool), "failed to create transfer command pool!");
+        if(dedicated) {
+            poolInfo.queueFamilyIndex = graphicsFamily;
+            VK_CHECK(vkCreateCommandPool(device_device, &poolInfo, nullptr, &acquirePool), "failed to create acquire command pool!");
+        }
+
+        VkSemaphoreTypeCreateInfo typeInfo{};
+        typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeInfo.initialValue = 0;
+
+        VkSemaphoreCreateInfo semaphoreInfo{};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreInfo.pNext = &typeInfo;
+        VK_CHECK(vkCreateSemaphore(device_device, &semaphoreInfo, nullptr, &timeline), "failed to create upload timeline semaphore!");
+        if(dedicated) {
+            VK_CHECK(vkCreateSemaphore(device_device, &semaphoreInfo, nullptr, &releaseTimeline),
+                     "failed to create upload release timeline semaphore!");
+        }
+
+        LINFO("Upload engine: {} (family {})", dedicated ? "dedicated transfer queue" : "graphics queue", transferFamily);
+    }
+
+    UploadEngine::~UploadEngine() {
+        waitIdle();
+        const auto device_device = lveDevice.device();
+        vkDestroySemaphore(device_device, timeline, nullptr);
+        if(releaseTimeline != VK_NULL_HANDLE) { vkDestroySemaphore(device_device, releaseTimeline, nullptr); }
+        vkDestroyCommandPool(device_device, transferPool, nullptr);
+        if(acquirePool != VK_NULL_HANDLE) { vkDestroyCommandPool(device_device, acquirePool, nullptr); }
+    }
+
+    uint64_t UploadEngine::counterValue() const {
+        uint64_t value = 0;
+        VK_CHECK(vkGetSemaphoreCounterValue(lveDevice.device(), timeline, &value), "failed to query upload timeline!");
+        return value;
+    }
+
+    bool UploadEngine::isComplete(UploadTicket ticket) const { return counterValue() >= ticket; }
+
+    void UploadEngine::wait(UploadTicket ticket) const {
+        if(ticket == 0) { return; }
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &timeline;
+        waitInfo.pValues = &ticket;
+        VK_CHECK(vkWaitSemaphores(lveDevice.device(), &waitInfo, MAXU64), "failed to wait for upload!");
+    }
+
+    void UploadEngine::recycle() {
+        const uint64_t completed = counterValue();
+        while(!inFlight.empty() && inFlight.front().ticket <= completed) {
+            const Submission &done = inFlight.front();
+            freeTransfer.emplace_back(done.transfer);
+            if(done.acquire != VK_NULL_HANDLE) { freeAcquire.emplace_back(done.acquire); }
+            inFlight.pop_front();
+        }
+    }
+
+    VkCommandBuffer UploadEngine::obtain(VkCommandPool pool, std::vector<VkCommandBuffer> &freeList) {
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        if(!freeList.empty()) {
+            commandBuffer = freeList.back();
+            freeList.pop_back();
+            vkResetCommandBuffer(commandBuffer, 0);
+        } else {
+            VkCommandBufferAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandPool = pool;
+            allocInfo.commandBufferCount = 1;
+            VK_CHECK(vkAllocateCommandBuffers(lveDevice.device(), &allocInfo, &commandBuffer), "failed to allocate upload command buffer!");
+        }
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        VK_CHECK(vkBeginCommandBuffer(commandBuffer, &beginInfo), "failed to begin upload command buffer!");
+        return commandBuffer;
+    }
+
+    void UploadEngine::submitTo(VkQueue queue, VkCommandBuffer commandBuffer, VkSemaphore waitSemaphore, uint64_t waitValue,
+                                VkPipelineStageFlags waitStage, VkSemaphore signalSemaphore, uint64_t signalValue) {
+        VkTimelineSemaphoreSubmitInfo timelineInfo{};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineInfo.waitSemaphoreValueCount = waitValue != 0 ? 1 : 0;
+        timelineInfo.pWaitSemaphoreValues = &waitValue;
+        timelineInfo.signalSemaphoreValueCount = 1;
+        timelineInfo.pSignalSemaphoreValues = &signalValue;
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext = &timelineInfo;
+        submitInfo.waitSemaphoreCount = waitValue != 0 ? 1 : 0;
+        submitInfo.pWaitSemaphores = &waitSemaphore;
+        submitInfo.pWaitDstStageMask = &waitStage;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &commandBuffer;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &signalSemaphore;
+
+        VK_CHECK(vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE), "failed to submit upload command buffer!");
+    }
+
+    void UploadBatch::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size, VkDeviceSize srcOffset, VkDeviceSize dstOffset) {
+        const auto [it, inserted] = bufferLookup.try_emplace({srcBuffer, dstBuffer}, bufferCopies.size());
+        if(inserted) { bufferCopies.emplace_back(BufferCopies{.src = srcBuffer, .dst = dstBuffer, .regions = {}}); }
+        bufferCopies[it->second].regions.emplace_back(VkBufferCopy{.srcOffset = srcOffset, .dstOffset = dstOffset, .size = size});
+        regionCount_++;
+        byteCount_ += size;
+    }
+
+    void UploadBatch::copyBufferToImage(VkBuffer buffer, VkImage image, const VkBufferImageCopy &region, VkImageLayout finalLayout,
+                                        VkImageLayout initialLayout) {
+        const auto [it, inserted] = imageLookup.try_emplace(image, imageCopies.size());
+        if(inserted) {
+            imageCopies.emplace_back(ImageCopies{.src = buffer,
+                                                 .image = image,
+                                                 .initialLayout = initialLayout,
+                                                 .finalLayout = finalLayout,
+                                                 .range = {region.imageSubresource.aspectMask, 0, VK_REMAINING_MIP_LEVELS, 0,
+                                                           VK_REMAINING_ARRAY_LAYERS},
+                                                 .regions = {}});
+        }
+        ImageCopies &copies = imageCopies[it->second];
+        if(copies.src != buffer) [[unlikely]] { throw std::runtime_error("all copies into an image of a batch must share the staging buffer"); }
+        copies.regions.emplace_back(region);
+        regionCount_++;
+    }
+
+    void UploadBatch::copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height, uint32_t layerCount,
+                                        VkImageLayout finalLayout, VkImageLayout initialLayout) {
+        VkBufferImageCopy region{};
+        region.bufferOffset = 0;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = 0;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = layerCount;
+
+        region.imageOffset = {0, 0, 0};
+        region.imageExtent = {width, height, 1};
+        copyBufferToImage(buffer, image, region, finalLayout, initialLayout);
+    }
+
+    void UploadBatch::coalesce() {
+        // N small uploads packed back to back in one staging buffer usually collapse into a handful of regions
+        for(auto &[src, dst, regions] : bufferCopies) {
+            std::ranges::sort(regions, {}, &VkBufferCopy::srcOffset);
+            std::vector<VkBufferCopy> merged;
+            merged.reserve(regions.size());
+            for(const auto &region : regions) {
+                if(!merged.empty()) {
+                    VkBufferCopy &last = merged.back();
+                    if(last.srcOffset + last.size == region.srcOffset && last.dstOffset + last.size == region.dstOffset) {
+                        last.size += region.size;
+                        continue;
+                    }
+                }
+                merged.emplace_back(region);
+            }
+            regions = std::move(merged);
+        }
+    }
+
+    void UploadEngine::recordCopies(VkCommandBuffer commandBuffer, const UploadBatch &batch) const {
+        std::vector<VkImageMemoryBarrier> toTransfer;
+        toTransfer.reserve(batch.imageCopies.size());
+        for(const auto &copies : batch.imageCopies) {
+            if(copies.initialLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) { continue; }
+            VkImageMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.oldLayout = copies.initialLayout;
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = copies.image;
+            barrier.subresourceRange = copies.range;
+            toTransfer.emplace_back(barrier);
+        }
+        if(!toTransfer.empty()) {
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr,
+                                 C_UI32T(toTransfer.size()), toTransfer.data());
+        }
+
+        for(const auto &[src, dst, regions] : batch.bufferCopies) {
+            vkCmdCopyBuffer(commandBuffer, src, dst, C_UI32T(regions.size()), regions.data());
+        }
+        for(const auto &copies : batch.imageCopies) {
+            vkCmdCopyBufferToImage(commandBuffer, copies.src, copies.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                   C_UI32T(copies.regions.size()), copies.regions.data());
+        }
+    }
+
+    void UploadEngine::recordPostBarriers(VkCommandBuffer commandBuffer, const UploadBatch &batch, uint32_t srcFamily, uint32_t dstFamily,
+                                          bool release) const {
+        // the release half only needs the source scope, the acquire half only the destination scope; on a shared family
+        // (srcFamily == dstFamily == IGNORED) a single barrier covers both
+        const bool sameFamily = srcFamily == dstFamily;
+        const VkAccessFlags srcAccess = release || sameFamily ? VK_ACCESS_TRANSFER_WRITE_BIT : 0;
+        const VkAccessFlags dstAccess = release && !sameFamily ? 0 : VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+        const VkPipelineStageFlags srcStage = release || sameFamily ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        const VkPipelineStageFlags dstStage = release && !sameFamily ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT
+                                                                     : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+        std::vector<VkBufferMemoryBarrier> bufferBarriers;
+        bufferBarriers.reserve(batch.bufferCopies.size());
+        for(const auto &copies : batch.bufferCopies) {
+            VkBufferMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            barrier.srcAccessMask = srcAccess;
+            barrier.dstAccessMask = dstAccess;
+            barrier.srcQueueFamilyIndex = srcFamily;
+            barrier.dstQueueFamilyIndex = dstFamily;
+            barrier.buffer = copies.dst;
+            barrier.offset = 0;
+            barrier.size = VK_WHOLE_SIZE;
+            bufferBarriers.emplace_back(barrier);
+        }
+
+        std::vector<VkImageMemoryBarrier> imageBarriers;
+        imageBarriers.reserve(batch.imageCopies.size());
+        for(const auto &copies : batch.imageCopies) {
+            VkImageMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcAccessMask = srcAccess;
+            barrier.dstAccessMask = dstAccess;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = copies.finalLayout;
+            barrier.srcQueueFamilyIndex = srcFamily;
+            barrier.dstQueueFamilyIndex = dstFamily;
+            barrier.image = copies.image;
+            barrier.subresourceRange = copies.range;
+            imageBarriers.emplace_back(barrier);
+        }
+
+        vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, C_UI32T(bufferBarriers.size()), bufferBarriers.data(),
+                             C_UI32T(imageBarriers.size()), imageBarriers.data());
+    }
+
+    UploadTicket UploadEngine::flush(UploadBatch &&batch) {
+        if(batch.empty()) { return lastTicket; }
+        batch.coalesce();
+
+        const std::scoped_lock lock{mutex};
+        recycle();
+
+        Submission submission{};
+        submission.transfer = obtain(transferPool, freeTransfer);
+        recordCopies(submission.transfer, batch);
+
+        if(!dedicated) {
+            recordPostBarriers(submission.transfer, batch, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, false);
+            VK_CHECK(vkEndCommandBuffer(submission.transfer), "failed to record upload command buffer!");
+            submission.ticket = nextValue++;
+            submitTo(lveDevice.graphicsQueue(), submission.transfer, VK_NULL_HANDLE, 0, 0, timeline, submission.ticket);
+        } else {
+            recordPostBarriers(submission.transfer, batch, transferFamily, graphicsFamily, true);
+            VK_CHECK(vkEndCommandBuffer(submission.transfer), "failed to record upload command buffer!");
+
+            submission.acquire = obtain(acquirePool, freeAcquire);
+            recordPostBarriers(submission.acquire, batch, transferFamily, graphicsFamily, false);
+            VK_CHECK(vkEndCommandBuffer(submission.acquire), "failed to record acquire command buffer!");
+
+            // one timeline per queue, so each only ever moves forward: the release signals its own value on the transfer
+            // queue, the acquire waits for it and signals the ticket on the graphics queue, after the acquire has run
+            const uint64_t released = nextRelease++;
+            submission.ticket = nextValue++;
+            submitTo(lveDevice.transferQueue(), submission.transfer, VK_NULL_HANDLE, 0, 0, releaseTimeline, released);
+            submitTo(lveDevice.graphicsQueue(), submission.acquire, releaseTimeline, released, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, timeline,
+                     submission.ticket);
+        }
+
+        lastTicket = submission.ticket;
+        inFlight.emplace_back(submission);
+        return submission.ticket;
+    }
+
+    UploadTicket UploadEngine::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size, VkDeviceSize srcOffset,
+                                          VkDeviceSize dstOffset) {
+        UploadBatch batch = beginBatch();
+        batch.copyBuffer(srcBuffer, dstBuffer, size, srcOffset, dstOffset);
+        return flush(std::move(batch));
+    }
+
+    UploadTicket UploadEngine::copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height, uint32_t layerCount) {
+        // legacy single copy: the image is expected in, and left in, TRANSFER_DST_OPTIMAL
+        UploadBatch batch = beginBatch();
+        batch.copyBufferToImage(buffer, image, width, height, layerCount, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+        return flush(std::move(batch));
+    }
+
+}  // namespace lve
+
+// NOLINTEND(*-include-cleaner, *-signed-bitwise)
@@ -19,7 +19,10 @@ namespace lve {
             }
             break;
         [[likely]] default:
-            // Handle other keys here
+            // everything else is left to the application, see takeKeyPress
+            if(action == GLFW_PRESS) {
+                if(auto *self = static_cast<Window *>(glfwGetWindowUserPointer(window)); self != nullptr) { self->onKeyPress(key); }
+            }
             break;
         }
     }
@@ -52,6 +55,15 @@ namespace lve {
             throw std::runtime_error("Failed to create GLFW window.");
         }
         glfwSetKeyCallback(window, keyCallback);
+        glfwSetWindowUserPointer(window, this);
+        glfwSetFramebufferSizeCallback(window, framebufferResizeCallback);
+    }
+
+    void Window::framebufferResizeCallback(GLFWwindow *glfwWindow, int newWidth, int newHeight) noexcept {
+        auto *self = static_cast<Window *>(glfwGetWindowUserPointer(glfwWindow));
+        self->framebufferResized = true;
+        self->width = newWidth;
+        self->height = newHeight;
     }
 
     void Window::setHints() const {
@@ -123,7 +135,6 @@ namespace lve {
         glfwGetMonitorPhysicalSize(primaryMonitor, &monitorPhysicalWidth, &monitorPhysicalHeight);
         LINFO("{}", tmonitorinfo);
 
-        glfwSetWindowUserPointer(window, this);
         glfwShowWindow(window);
         LINFO("Monitor:\"{}\", Phys:{}x{}mm, Scale:({}/{}), Pos:({}/{})", glfwGetMonitorName(primaryMonitor), monitorPhysicalWidth,
               monitorPhysicalHeight, xScale, yScale, xPos, yPos);
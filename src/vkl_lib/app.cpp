@@ -3,13 +3,17 @@
 // clang-format on
 #include "vkl/app.hpp"
 #include <vkl/FPSCounter.hpp>
+#include <vkl/MeshCache.hpp>
+#include <vkl/MeshOptimizer.hpp>
+#include <vkl/ObjLoader.hpp>
 
 namespace lve {
 
     App::App() {
+        loadModels();
+        recreateSwapChain();
         createPipelineLayout();
         createPipeline();
-        createCommandBuffers();
     }
 
     App::~App() { vkDestroyPipelineLayout(lveDevice.device(), pipelineLayout, nullptr); }
@@ -19,80 +23,447 @@ namespace lve {
         while(!lveWindow.shouldClose()) {
             fpsCounter.frameInTitle();
             glfwPollEvents();
+            handlePresentPolicyKeys();
             drawFrame();
         }
 
         vkDeviceWaitIdle(lveDevice.device());
     }
 
+    RenderingMode App::chooseRenderingMode(const Device &device) {
+        // NOLINTNEXTLINE(*-mt-unsafe)
+        const char *env = std::getenv("VKL_DYNAMIC_RENDERING");
+        const bool disabled = env != nullptr && std::string_view{env} == "0";
+        const RenderingMode mode = device.supportsDynamicRendering() && !disabled ? RenderingMode::Dynamic : RenderingMode::RenderPass;
+        LINFO("Rendering mode: {}", mode == RenderingMode::Dynamic ? "dynamic rendering" : "render pass");
+        return mode;
+    }
+
+    std::size_t App::drawCountFromEnvironment() {
+        std::size_t count = 1;
+        // NOLINTNEXTLINE(*-mt-unsafe)
+        if(const char *env = std::getenv("VKL_DRAW_COUNT"); env != nullptr) {
+            const std::string_view value{env};
+            if(const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), count); ec != std::errc{} || count == 0) {
+                LWARN("Ignoring VKL_DRAW_COUNT={}, expected a positive number", value);
+                count = 1;
+            }
+        }
+        return count;
+    }
+
+    VertexFormat App::vertexFormatFromEnvironment() {
+        // NOLINTNEXTLINE(*-mt-unsafe)
+        const char *env = std::getenv("VKL_QUANTIZE");
+        const VertexFormat format = env != nullptr && std::string_view{env} == "1" ? VertexFormat::Quantized : VertexFormat::Float;
+        LINFO("Vertex format: {}", format == VertexFormat::Quantized ? "quantized" : "float");
+        return format;
+    }
+
+    bool App::gpuDrivenFromEnvironment() {
+        // NOLINTNEXTLINE(*-mt-unsafe)
+        const char *env = std::getenv("VKL_GPU_DRIVEN");
+        const bool enabled = env != nullptr && std::string_view{env} == "1";
+        LINFO("Draw submission: {}", enabled ? "GPU driven indirect" : "per draw");
+        return enabled;
+    }
+
+    bool App::occlusionFromEnvironment(bool gpuDriven, RenderingMode mode) {
+        // NOLINTNEXTLINE(*-mt-unsafe)
+        const char *env = std::getenv("VKL_OCCLUSION");
+        if(env == nullptr || std::string_view{env} != "1") { return false; }
+        // the depth pyramid is built between two halves of the frame, which a render pass object cannot be split into
+        if(!gpuDriven || mode != RenderingMode::Dynamic) {
+            LWARN("Ignoring VKL_OCCLUSION=1, occlusion culling needs VKL_GPU_DRIVEN=1 and dynamic rendering");
+            return false;
+        }
+        LINFO("Occlusion culling: two-phase hierarchical Z");
+        return true;
+    }
+
+    void App::loadModels() {
+        if(gpuDriven) {
+            if(vertexFormat == VertexFormat::Quantized) {
+                LWARN("The GPU scene stores float vertices, ignoring VKL_QUANTIZE");
+                vertexFormat = VertexFormat::Float;
+            }
+            // NOLINTNEXTLINE(*-mt-unsafe)
+            if(const char *env = std::getenv("VKL_MODEL"); env != nullptr) {
+                MeshData mesh = ObjLoader::load(Window::calculateRelativePathToSrcModels(curentP, env), recordPool);
+                MeshOptimizer::optimize(mesh);
+                buildScene(mesh);
+            } else {
+                buildScene(MeshData{.vertices = {Model::Vertex{{0.0f, -0.5f, 0.0f}, {1.0f, 0.0f, 0.0f}},
+                                                 Model::Vertex{{0.5f, 0.5f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+                                                 Model::Vertex{{-0.5f, 0.5f, 0.0f}, {0.0f, 0.0f, 1.0f}}},
+                                    .indices = {0, 1, 2}});
+            }
+            return;
+        }
+        // NOLINTNEXTLINE(*-mt-unsafe)
+        if(const char *env = std::getenv("VKL_MODEL"); env != nullptr) {
+            const MeshCache meshCache{};
+            lveModel = meshCache.loadObj(lveDevice, Window::calculateRelativePathToSrcModels(curentP, env), recordPool, vertexFormat);
+            return;
+        }
+        const std::array<Model::Vertex, 3> vertices{Model::Vertex{{0.0f, -0.5f, 0.0f}, {1.0f, 0.0f, 0.0f}},
+                                                    Model::Vertex{{0.5f, 0.5f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+                                                    Model::Vertex{{-0.5f, 0.5f, 0.0f}, {0.0f, 0.0f, 1.0f}}};
+        const std::array<uint32_t, 3> indices{0, 1, 2};
+        if(vertexFormat == VertexFormat::Quantized) {
+            lveModel = MAKE_UNIQUE(Model, lveDevice, Model::quantizeVertices(vertices), indices, Model::Bounds::of(vertices));
+        } else {
+            lveModel = MAKE_UNIQUE(Model, lveDevice, vertices, indices);
+        }
+    }
+
+    void App::buildScene(const MeshData &mesh) {
+        gpuScene = MAKE_UNIQUE(GpuScene, lveDevice);
+        const uint32_t meshId = gpuScene->addMesh(mesh);
+        const Model::Bounds &bounds = gpuScene->mesh(meshId).bounds;
+
+        // each instance is fitted into its own cell of a square grid in clip space, pushed to mid depth
+        const auto side = C_UI32T(std::ceil(std::sqrt(C_D(drawCount))));
+        const float cell = 2.0f / C_F(side);
+        const float scale = 0.45f * cell / std::max(bounds.radius, 1e-6f);
+        const glm::mat4 fit = glm::scale(glm::mat4{1.0f}, glm::vec3{scale}) * glm::translate(glm::mat4{1.0f}, -bounds.center);
+        for(std::size_t object = 0; object < drawCount; object++) {
+            const auto column = C_F(object % side);
+            const auto row = C_F(object / side);
+            const glm::vec3 center{-1.0f + (column + 0.5f) * cell, -1.0f + (row + 0.5f) * cell, 0.5f};
+            gpuScene->addObject(glm::translate(glm::mat4{1.0f}, center) * fit, meshId);
+        }
+        gpuScene->build();
+        gpuCuller = MAKE_UNIQUE(GpuCuller, lveDevice, *gpuScene, SwapChain::MAX_FRAMES_IN_FLIGHT);
+    }
+
     void App::createPipelineLayout() {
+        const VkDescriptorSetLayout sceneLayout = gpuScene ? gpuScene->descriptorSetLayout() : VK_NULL_HANDLE;
         VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
         pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        pipelineLayoutInfo.setLayoutCount = 0;
-        pipelineLayoutInfo.pSetLayouts = nullptr;
-        pipelineLayoutInfo.pushConstantRangeCount = 0;
-        pipelineLayoutInfo.pPushConstantRanges = nullptr;
+        pipelineLayoutInfo.setLayoutCount = gpuScene ? 1 : 0;
+        pipelineLayoutInfo.pSetLayouts = gpuScene ? &sceneLayout : nullptr;
+        pipelineLayoutInfo.pushConstantRangeCount = gpuScene ? 1 : 0;
+        pipelineLayoutInfo.pPushConstantRanges = gpuScene ? &GpuScene::CAMERA_PUSH_CONSTANTS : nullptr;
         VK_CHECK(vkCreatePipelineLayout(lveDevice.device(), &pipelineLayoutInfo, nullptr, &pipelineLayout), "failed to create pipeline layout!");
     }
 
     void App::createPipeline() {
-        auto pipelineConfig = Pipeline::defaultPipelineConfigInfo(lveSwapChain.width(), lveSwapChain.height());
-        pipelineConfig.renderPass = lveSwapChain.getRenderPass();
+        PipelineConfigInfo pipelineConfig{};
+        Pipeline::defaultPipelineConfigInfo(pipelineConfig);
+        pipelineConfig.renderPass = lveSwapChain->getRenderPass();
+        pipelineConfig.colorFormat = lveSwapChain->getSwapChainImageFormat();
+        pipelineConfig.depthFormat = lveSwapChain->getDepthFormat();
         pipelineConfig.pipelineLayout = pipelineLayout;
+        if(vertexFormat == VertexFormat::Quantized) {
+            // position, color and uv expand to the same shader inputs, the shaders do not read the octahedral normal
+            pipelineConfig.bindingDescriptions = Model::QuantizedVertex::getBindingDescriptions();
+            pipelineConfig.attributeDescriptions = Model::QuantizedVertex::getAttributeDescriptions();
+        }
+        const std::string_view vertexShader = gpuScene ? "scene_shader.vert.opt.rmp.spv" : "simple_shader.vert.opt.rmp.spv";
         lvePipeline = MAKE_UNIQUE(
-            Pipeline, lveDevice, Window::calculateRelativePathToSrcShaders(curentP, "simple_shader.vert.opt.rmp.spv").string(),
+            Pipeline, lveDevice, Window::calculateRelativePathToSrcShaders(curentP, vertexShader).string(),
             Window::calculateRelativePathToSrcShaders(curentP, "simple_shader.frag.opt.rmp.spv").string(), pipelineConfig);
     }
 
-    void App::createCommandBuffers() {
-        commandBuffers.resize(lveSwapChain.imageCount());
+    void App::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
-        VkCommandBufferAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        allocInfo.commandPool = lveDevice.getCommandPool();
-        allocInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
+        if(vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+            throw std::runtime_error("failed to begin recording command buffer!");
+        }
 
-        VK_CHECK(vkAllocateCommandBuffers(lveDevice.device(), &allocInfo, commandBuffers.data()), "failed to allocate command buffers!");
+        // there is no camera yet, the object transforms go straight to clip space
+        const glm::mat4 viewProjection{1.0f};
+        const std::size_t frameIndex = lveSwapChain->getCurrentFrame();
+        if(occlusionCuller) {
+            occlusionCuller->recordEarly(commandBuffer, frameIndex, viewProjection);
+        } else if(gpuCuller) {
+            gpuCuller->record(commandBuffer, frameIndex, Frustum::fromViewProjection(viewProjection));
+        }
 
-        for(std::size_t i = 0; i < commandBuffers.size(); i++) {
-            VkCommandBufferBeginInfo beginInfo{};
-            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginRendering(commandBuffer, imageIndex);
+        executeDraws(commandBuffer, imageIndex);
 
-            if(vkBeginCommandBuffer(commandBuffers[i], &beginInfo) != VK_SUCCESS) {
-                throw std::runtime_error("failed to begin recording command buffer!");
-            }
+        // the objects visible last frame are drawn, their depth hides what the late phase tests; the survivors are drawn
+        // on top of them in the same attachments
+        if(occlusionCuller) {
+            vkCmdEndRendering(commandBuffer);
+            depthPyramid->build(commandBuffer, lveSwapChain->getDepthImage(), lveSwapChain->getDepthFormat());
+            occlusionCuller->recordLate(commandBuffer, frameIndex, viewProjection);
+            beginRendering(commandBuffer, imageIndex, true);
+            executeDraws(commandBuffer, imageIndex);
+        }
+
+        endRendering(commandBuffer, imageIndex);
+        if(vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) { throw std::runtime_error("failed to record command buffer!"); }
+    }
 
+    void App::executeDraws(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+        // the draws are recorded on the worker threads into secondary buffers that inherit the render pass (or the
+        // dynamic rendering formats), the primary only begins, executes and ends
+        const VkFormat colorFormat = lveSwapChain->getSwapChainImageFormat();
+        VkCommandBufferInheritanceRenderingInfo renderingInheritance{};
+        renderingInheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+        renderingInheritance.colorAttachmentCount = 1;
+        renderingInheritance.pColorAttachmentFormats = &colorFormat;
+        renderingInheritance.depthAttachmentFormat = lveSwapChain->getDepthFormat();
+        renderingInheritance.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+        VkCommandBufferInheritanceInfo inheritance{};
+        inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        if(renderingMode == RenderingMode::RenderPass) {
+            inheritance.renderPass = lveSwapChain->getRenderPass();
+            inheritance.subpass = 0;
+            inheritance.framebuffer = lveSwapChain->getFrameBuffer(C_I(imageIndex));
+        } else {
+            inheritance.pNext = &renderingInheritance;
+        }
+
+        // the GPU driven path records the same two commands whatever the object count, one secondary is enough
+        const auto secondaries = frameContext.recordSecondary(
+            recordPool, inheritance, gpuScene ? 1 : drawCount,
+            [this](VkCommandBuffer secondary, std::size_t first, std::size_t count) { recordDraws(secondary, first, count); });
+        vkCmdExecuteCommands(commandBuffer, C_UI32T(secondaries.size()), secondaries.data());
+    }
+
+    void App::recordDraws(VkCommandBuffer commandBuffer, std::size_t /*firstDraw*/, std::size_t count) {
+        // dynamic state is not inherited by secondary command buffers
+        const VkExtent2D extent = lveSwapChain->getSwapChainExtent();
+        const VkViewport viewport{.x = 0.0f,
+                                  .y = 0.0f,
+                                  .width = static_cast<float>(extent.width),
+                                  .height = static_cast<float>(extent.height),
+                                  .minDepth = 0.0f,
+                                  .maxDepth = 1.0f};
+        const VkRect2D scissor{.offset = {0, 0}, .extent = extent};
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+        lvePipeline->bind(commandBuffer);
+        if(gpuScene) {
+            gpuScene->bind(commandBuffer, pipelineLayout);
+            gpuScene->draw(commandBuffer);
+            return;
+        }
+        lveModel->bind(commandBuffer);
+        for(std::size_t draw = 0; draw < count; draw++) { lveModel->draw(commandBuffer); }
+    }
+
+    void App::beginRendering(VkCommandBuffer commandBuffer, uint32_t imageIndex, bool resume) {
+        const VkExtent2D extent = lveSwapChain->getSwapChainExtent();
+        const VkClearValue colorClear{.color = VkClearColorValue{.float32{0.1f, 0.1f, 0.1f, 1.0f}}};
+        const VkClearValue depthClear{.depthStencil = {.depth = 1.0f, .stencil = 0}};
+
+        if(renderingMode == RenderingMode::RenderPass) {
+            const std::array<VkClearValue, 2> clearValues{colorClear, depthClear};
             VkRenderPassBeginInfo renderPassInfo{};
             renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-            renderPassInfo.renderPass = lveSwapChain.getRenderPass();
-            renderPassInfo.framebuffer = lveSwapChain.getFrameBuffer(C_I(i));
-
+            renderPassInfo.renderPass = lveSwapChain->getRenderPass();
+            renderPassInfo.framebuffer = lveSwapChain->getFrameBuffer(C_I(imageIndex));
             renderPassInfo.renderArea.offset = {0, 0};
-            renderPassInfo.renderArea.extent = lveSwapChain.getSwapChainExtent();
-
-            std::array<VkClearValue, 2> clearValues{};
-            clearValues[0].color = VkClearColorValue{.float32{0.1f, 0.1f, 0.1f, 1.0f}};
-            clearValues[1].depthStencil = {.depth = 1.0f, .stencil = 0};
+            renderPassInfo.renderArea.extent = extent;
             renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
             renderPassInfo.pClearValues = clearValues.data();
+            vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+            return;
+        }
+
+        // without a render pass the layout transitions and the external dependencies are recorded by hand: the color
+        // barrier chains on the acquire semaphore wait (COLOR_ATTACHMENT_OUTPUT), the depth one orders this frame's
+        // clear after the previous frame's writes to the shared depth image
+        const VkImageAspectFlags depthAspect =
+            lveSwapChain->getDepthFormat() == VK_FORMAT_D32_SFLOAT ? VK_IMAGE_ASPECT_DEPTH_BIT
+                                                                   : VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        if(resume) {
+            // DepthPyramid::build already handed the depth image back, only the color writes of the first half need ordering
+            VkImageMemoryBarrier colorBarrier{};
+            colorBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            colorBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            colorBarrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            colorBarrier.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            colorBarrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            colorBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            colorBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            colorBarrier.image = lveSwapChain->getImage(C_I(imageIndex));
+            colorBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                 VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0, 0, nullptr, 0, nullptr, 1, &colorBarrier);
+        } else {
+            std::array<VkImageMemoryBarrier, 2> barriers{};
+            barriers[0].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barriers[0].srcAccessMask = 0;
+            barriers[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            barriers[0].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barriers[0].newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            barriers[0].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barriers[0].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barriers[0].image = lveSwapChain->getImage(C_I(imageIndex));
+            barriers[0].subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+            barriers[1].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barriers[1].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            barriers[1].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            barriers[1].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barriers[1].newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            barriers[1].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barriers[1].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barriers[1].image = lveSwapChain->getDepthImage();
+            barriers[1].subresourceRange = {depthAspect, 0, 1, 0, 1};
+            vkCmdPipelineBarrier(commandBuffer,
+                                 VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                     VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                                 VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT, 0, 0,
+                                 nullptr, 0, nullptr, C_UI32T(barriers.size()), barriers.data());
+        }
+
+        VkRenderingAttachmentInfo colorAttachment{};
+        colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+        colorAttachment.imageView = lveSwapChain->getImageView(C_I(imageIndex));
+        colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        colorAttachment.loadOp = resume ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_CLEAR;
+        colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        colorAttachment.clearValue = colorClear;
+
+        VkRenderingAttachmentInfo depthAttachment{};
+        depthAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+        depthAttachment.imageView = lveSwapChain->getDepthImageView();
+        depthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        depthAttachment.loadOp = resume ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_CLEAR;
+        // the first half of an occlusion culled frame leaves the depth behind for the pyramid
+        depthAttachment.storeOp = occlusionCuller && !resume ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachment.clearValue = depthClear;
+
+        VkRenderingInfo renderingInfo{};
+        renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+        renderingInfo.flags = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT;
+        renderingInfo.renderArea = {.offset = {0, 0}, .extent = extent};
+        renderingInfo.layerCount = 1;
+        renderingInfo.colorAttachmentCount = 1;
+        renderingInfo.pColorAttachments = &colorAttachment;
+        renderingInfo.pDepthAttachment = &depthAttachment;
+        vkCmdBeginRendering(commandBuffer, &renderingInfo);
+    }
+
+    void App::endRendering(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+        if(renderingMode == RenderingMode::RenderPass) {
+            vkCmdEndRenderPass(commandBuffer);
+            return;
+        }
+        vkCmdEndRendering(commandBuffer);
 
-            vkCmdBeginRenderPass(commandBuffers[i], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+        // the present engine waits on the render finished semaphore, which covers all stages, so the destination
+        // needs no stage or access of its own
+        VkImageMemoryBarrier toPresent{};
+        toPresent.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        toPresent.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        toPresent.dstAccessMask = 0;
+        toPresent.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        toPresent.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        toPresent.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toPresent.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toPresent.image = lveSwapChain->getImage(C_I(imageIndex));
+        toPresent.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0,
+                             nullptr, 0, nullptr, 1, &toPresent);
+    }
+
+    void App::recreateSwapChain() {
+        auto extent = lveWindow.getExtent();
+        // a minimized window has a zero sized framebuffer, nothing can be presented until it comes back
+        while(extent.width == 0 || extent.height == 0) {
+            glfwWaitEvents();
+            extent = lveWindow.getExtent();
+        }
 
-            lvePipeline->bind(commandBuffers[i]);
-            vkCmdDraw(commandBuffers[i], 3, 1, 0, 0);
+        const VkRenderPass oldRenderPass = lveSwapChain ? lveSwapChain->getRenderPass() : VK_NULL_HANDLE;
+        const VkFormat oldFormat = lveSwapChain ? lveSwapChain->getSwapChainImageFormat() : VK_FORMAT_UNDEFINED;
+        lveSwapChain = MAKE_UNIQUE(SwapChain, lveDevice, extent, presentPolicy, renderingMode, std::move(lveSwapChain), occlusion);
+
+        // the pyramid follows the depth image; frames still in flight may be reading the old one
+        if(occlusion && gpuScene) {
+            if(depthPyramid) { vkQueueWaitIdle(lveDevice.graphicsQueue()); }
+            depthPyramid = MAKE_UNIQUE(DepthPyramid, lveDevice, lveSwapChain->getSwapChainExtent(), lveSwapChain->getDepthImageView());
+            if(occlusionCuller) {
+                occlusionCuller->setPyramid(*depthPyramid);
+            } else {
+                occlusionCuller = MAKE_UNIQUE(OcclusionCuller, lveDevice, *gpuScene, *depthPyramid, SwapChain::MAX_FRAMES_IN_FLIGHT);
+            }
+        }
+
+        // pipelines depend on the render pass, or with dynamic rendering only on the attachment formats; either is
+        // only replaced when the surface format changed, which is rare enough that draining the graphics queue
+        // before dropping the pipeline built against it is fine
+        const bool targetsChanged = renderingMode == RenderingMode::Dynamic ? lveSwapChain->getSwapChainImageFormat() != oldFormat
+                                                                            : lveSwapChain->getRenderPass() != oldRenderPass;
+        if(lvePipeline && targetsChanged) {
+            vkQueueWaitIdle(lveDevice.graphicsQueue());
+            createPipeline();
+        }
+    }
 
-            vkCmdEndRenderPass(commandBuffers[i]);
-            if(vkEndCommandBuffer(commandBuffers[i]) != VK_SUCCESS) { throw std::runtime_error("failed to record command buffer!"); }
+    // F1-F4 pick immediate, mailbox, fifo and fifo_relaxed, F5 cycles the number of frames in flight
+    void App::handlePresentPolicyKeys() {
+        switch(lveWindow.takeKeyPress()) {
+        case GLFW_KEY_F1:
+            presentPolicy.mode = PresentMode::Immediate;
+            break;
+        case GLFW_KEY_F2:
+            presentPolicy.mode = PresentMode::Mailbox;
+            break;
+        case GLFW_KEY_F3:
+            presentPolicy.mode = PresentMode::Fifo;
+            break;
+        case GLFW_KEY_F4:
+            presentPolicy.mode = PresentMode::FifoRelaxed;
+            break;
+        case GLFW_KEY_F5:
+            presentPolicy.framesInFlight = lveSwapChain->framesInFlight() % C_UI32T(SwapChain::MAX_FRAMES_IN_FLIGHT) + 1;
+            break;
+        default:
+            return;
         }
+        LINFO("Present policy: {}, {} frames in flight", toString(presentPolicy.mode), presentPolicy.framesInFlight);
+        recreateSwapChain();
     }
+
     void App::drawFrame() {
         uint32_t imageIndex;  // NOLINT(*-init-variables)
-        auto result = lveSwapChain.acquireNextImage(&imageIndex);
+        auto result = lveSwapChain->acquireNextImage(&imageIndex);
+        if(result == VK_ERROR_OUT_OF_DATE_KHR) {
+            recreateSwapChain();
+            return;
+        }
         if(result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) { throw std::runtime_error("failed to acquire swap chain image!"); }
 
-        result = lveSwapChain.submitCommandBuffers(&commandBuffers[imageIndex], &imageIndex);
-        if(result != VK_SUCCESS) { throw std::runtime_error("failed to present swap chain image!"); }
+        // the last frame recorded in this slot has retired, its ring region and command pools are free to reuse
+        const auto frameIndex = lveSwapChain->getCurrentFrame();
+        frameRing.beginFrame(frameIndex);
+        frameContext.beginFrame(frameIndex);
+        if(gpuCuller) {
+            if(const auto stats = gpuCuller->stats(frameIndex); stats && stats != cullStats) {
+                LINFO("GPU culling: {} visible, {} culled", stats->visible, stats->culled);
+                cullStats = stats;
+            }
+        }
+        if(occlusionCuller) {
+            if(const auto stats = occlusionCuller->stats(frameIndex); stats && stats != occlusionStats) {
+                LINFO("Occlusion culling: {} early draws, {} late draws, {} culled, {} triangles", stats->earlyDraws, stats->lateDraws,
+                      stats->culled, stats->triangles);
+                occlusionStats = stats;
+            }
+        }
+        VkCommandBuffer commandBuffer = frameContext.commandBuffer();
+        recordCommandBuffer(commandBuffer, imageIndex);
+
+        result = lveSwapChain->submitCommandBuffers(&commandBuffer, &imageIndex);
+        if(result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || lveWindow.wasWindowResized()) {
+            lveWindow.resetWindowResizedFlag();
+            recreateSwapChain();
+        } else if(result != VK_SUCCESS) {
+            throw std::runtime_error("failed to present swap chain image!");
+        }
     }
 
 }  // namespace lve